@@ -27,34 +27,38 @@
  * 
  */
 #include "adc.h"
+#include "../systemControl/powerManager.h"
+
+Adc* Adc::interruptOwner[2][4];
+void (*Adc::dcHandler[2][8])(uint32_t adcModule, uint32_t dc, void* context);
+void* Adc::dcHandlerContext[2][8];
+uint32_t Adc::resolution;
+adcStatistics Adc::statistics[2][4];
 
 /**
- * @brief empty constructor placeholder
+ * @brief Marks the object as holding no clock, so the destructor and a
+ *        re-initialization release nothing until one is acquired.
  */
 Adc::Adc()
 {
-
+    clockAcquired = false;
 }
 
 /**
- * @brief empty deconstructor placeholder
+ * @brief Releases the ADC module clock if the module was initialized.
  */
 Adc::~Adc()
 {
-
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::adc, (0x1 << adcModule), (uint32_t)clockGateMode::run);
+    }
 }
 
 void Adc::initializeModule(uint32_t adcModule, uint32_t sequencerPriority, uint32_t hardwareAveraging, uint32_t phaseDelay)
 {
-    (*this).adcModule = adcModule;
-    baseAddress = adc0BaseAddress + (adcModule * 0x1000);
-
     //0. Enable ADC module clock
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCGCADC_OFFSET)), (uint32_t)setORClear::set, adcModule, 1, RW);
-    while(Register::getRegisterBitFieldStatus((volatile uint32_t*)(systemControlBase + PRADC_OFFSET), adcModule, 1, RO) == 0)
-    {
-        //Ready??
-    }
+    acquireModule(adcModule);
 
     /*
      * 0.A If required by the application, reconfigure the sample sequencer 
@@ -70,7 +74,33 @@ void Adc::initializeModule(uint32_t adcModule, uint32_t sequencerPriority, uint3
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSAC_OFFSET)), hardwareAveraging, 0, 2 + 1, RW);
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCCTL_OFFSET)), hardwareAveraging == 0 ? 0x0 : 0x1, 6, 1, RW);
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSPC_OFFSET)), phaseDelay, 0, 3 + 1, RW);
-    
+
+    resolution = Register::getRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCPP_OFFSET)), 18, 22 - 18 + 1, RO);
+}
+
+/**
+ * @brief Selects the ADC module of this object and enables its clock without
+ *        touching the module wide settings.
+ * 
+ * @details Used by drivers that take one sample sequencer of a module the 
+ *          application may already be using, so the sequencer priorities, 
+ *          hardware averaging and phase delay set by \c initializeModule are
+ *          left as they are.
+ * 
+ * @param adcModule module to use, 0 or 1.
+ */
+void Adc::acquireModule(uint32_t adcModule)
+{
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::adc, (0x1 << (*this).adcModule), (uint32_t)clockGateMode::run);
+    }
+
+    (*this).adcModule = adcModule;
+    baseAddress = adc0BaseAddress + (adcModule * 0x1000);
+
+    PowerManager::acquire(clockGatedPeripheral::adc, (0x1 << adcModule), (uint32_t)clockGateMode::run);
+    clockAcquired = true;
 }
 
 /**
@@ -97,118 +127,314 @@ void Adc::initializeForInterrupt(uint32_t sampleSequencer, uint32_t sequencerTri
     (*this).inputSource = inputSource;
     (*this).sequencerControl = sequencerControl;
     initialization();
+    sampled = 0;
+    streamBuffer = 0;
+    interruptOwner[adcModule][sampleSequencer] = this;
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCIM_OFFSET)), (uint32_t)setORClear::set, sampleSequencer, 1, RW);
+    activateSequencerInterrupt(interruptPriority);
+}
 
-    if(adcModule == (uint32_t)adcModule::module0)
-    {
-        switch (sampleSequencer)
-        {
-            case (uint32_t)sampleSequencer::SS0:
-                Nvic::activateInterrupt(ADC_0_Sequence_0_Interrupt, interruptPriority);
-                break;
-
-            case (uint32_t)sampleSequencer::SS1:
-                Nvic::activateInterrupt(ADC_0_Sequence_1_Interrupt, interruptPriority);
-                break;
+/**
+ * @brief Initialization for a sample sequencer whose interrupt drains the 
+ *        FIFO and hands the samples to a callback.
+ * 
+ * @param sampleSequencer sequencer to use.
+ * @param sequencerTrigSrc trigger of the sequencer.
+ * @param inputSource input of each step.
+ * @param sequencerControl control bits of each step, IE and END set on the 
+ *        last step.
+ * @param sampled called from the interrupt with the drained samples, oldest
+ *        first, and \c context .
+ * @param context pointer passed to \c sampled , e.g. the object that owns 
+ *        the samples.
+ * @param interruptPriority priority of the sequencer interrupt, 0 to 7.
+ */
+void Adc::initializeForInterrupt(uint32_t sampleSequencer, uint32_t sequencerTrigSrc, uint32_t inputSource, uint32_t sequencerControl, void (*sampled)(uint16_t* samples, uint32_t count, void* context), void* context, uint32_t interruptPriority)
+{
+    initializeForInterrupt(sampleSequencer, sequencerTrigSrc, inputSource, sequencerControl, interruptPriority);
+    sampledContext = context;
+    (*this).sampled = sampled;
+}
 
-            case (uint32_t)sampleSequencer::SS2:
-                Nvic::activateInterrupt(ADC_0_Sequence_2_Interrupt, interruptPriority);
-                break;
+/**
+ * @brief Initialization for a sample sequencer that streams its results into
+ *        a ping-pong buffer with μDMA.
+ * 
+ * @details The sequencer interrupt stays masked in ADCIM, the IE bit of the 
+ *          last step only raises the μDMA burst request, so the sequence 
+ *          should be 1, 2, 4 or 8 steps long. The sequencer interrupt then 
+ *          fires once per completed half buffer and is serviced by the 
+ *          driver. Start the stream with 
+ *          \c enableSampleSequencer .
+ * 
+ * @param sampleSequencer sequencer to stream, its μDMA channel is used.
+ * @param sequencerTrigSrc trigger of the sequencer, e.g. continuous sampling 
+ *        or a timer.
+ * @param inputSource input of each step.
+ * @param sequencerControl control bits of each step, IE and END set on the 
+ *        last step.
+ * @param buffer samples in SRAM, 12-bit results.
+ * @param bufferLength number of samples in \c buffer , each half holds up to
+ *        1024 samples.
+ * @param blockReady called from \c serviceStream with every filled half.
+ * @param context pointer passed to \c blockReady .
+ * @param interruptPriority priority of the sequencer interrupt, 0 to 7.
+ */
+void Adc::initializeForStreaming(uint32_t sampleSequencer, uint32_t sequencerTrigSrc, uint32_t inputSource, uint32_t sequencerControl, uint16_t* buffer, uint32_t bufferLength, void (*blockReady)(uint16_t* samples, uint32_t count, void* context), void* context, uint32_t interruptPriority)
+{
+    uint32_t blockLength = bufferLength / 2;
 
-            case (uint32_t)sampleSequencer::SS3:
-                Nvic::activateInterrupt(ADC_0_Sequence_3_Interrupt, interruptPriority);
-                break;
-            
-            default:
-                break;
-        }
+    if(blockLength == 0)
+    {
+        return;
     }
 
-    else
+    if(blockLength > Dma::maxItemCount)
     {
-        switch (sampleSequencer)
-        {
-            case (uint32_t)sampleSequencer::SS0:
-                Nvic::activateInterrupt(ADC_1_Sequence_0_Interrupt, interruptPriority);
-                break;
+        blockLength = Dma::maxItemCount;
+    }
 
-            case (uint32_t)sampleSequencer::SS1:
-                Nvic::activateInterrupt(ADC_1_Sequence_1_Interrupt, interruptPriority);
-                break;
+    (*this).sampleSequencer = sampleSequencer;
+    (*this).sequencerTrigSrc = sequencerTrigSrc;
+    (*this).inputSource = inputSource;
+    (*this).sequencerControl = sequencerControl;
+    initialization();
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCIM_OFFSET)), (uint32_t)setORClear::clear, sampleSequencer, 1, RW);
 
-            case (uint32_t)sampleSequencer::SS2:
-                Nvic::activateInterrupt(ADC_1_Sequence_2_Interrupt, interruptPriority);
-                break;
+    //One burst moves one sequence, rounded down to a power of 2
+    uint32_t steps = getSequenceLength();
+    uint32_t arbitrationLog2 = 0;
 
-            case (uint32_t)sampleSequencer::SS3:
-                Nvic::activateInterrupt(ADC_1_Sequence_3_Interrupt, interruptPriority);
-                break;
-            
-            default:
-                break;
-        }
+    while((2u << arbitrationLog2) <= steps)
+    {
+        arbitrationLog2++;
     }
-    
-}
 
+    (*this).blockReady = blockReady;
+    blockReadyContext = context;
+    streamBuffer = buffer;
+    streamBlockLength = blockLength;
+    streamControl = Dma::makeControl(dmaSize::halfWord, dmaIncrement::none, dmaIncrement::halfWord, arbitrationLog2, blockLength, dmaMode::pingPong);
+    nextBlockAlternate = false;
+    sampled = 0;
+    interruptOwner[adcModule][sampleSequencer] = this;
+    streamBlockCount = 0;
+    streamOverrunCount = 0;
+
+    //ADC0 sequencers use channels 14 to 17 encoding 0, ADC1 channels 24 to 27 encoding 1
+    dmaChannel = ((adcModule == (uint32_t)adcModule::module0) ? 14 : 24) + sampleSequencer;
+
+    Dma::initialize();
+    Dma::disableChannel(dmaChannel);
+    Dma::assignChannel(dmaChannel, adcModule);
+    Dma::configureChannel(dmaChannel, true, false);
+    armStreamBlock(false);
+    armStreamBlock(true);
+    Dma::clearChannelInterrupt(dmaChannel);
+    Dma::enableChannel(dmaChannel);
+
+    activateSequencerInterrupt(interruptPriority);
+}
 
 void Adc::enableSampleSequencer(void)
 {
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCACTSS_OFFSET)), (uint32_t)setORClear::set, sampleSequencer, 1, RW);
 }
 
-void Adc::enableSampleSequencerDc(uint32_t dcOperation, uint32_t dcSelect)
+/**
+ * @brief Triggers the sample sequencer from a gpio pin edge or level in 
+ *        hardware, with no interrupt handler in between.
+ * 
+ * @details Call after \c initializeForPolling or \c initializeForInterrupt.
+ *          The sequencer trigger is changed to \c ssTriggerSource::gpio, with
+ *          the sequencer disabled while the ADCEMUX field is written, and the 
+ *          pin is set up as ADC trigger. The trigger is shared by every 
+ *          sequencer using the gpio trigger on both ADC modules.
+ * 
+ * @param trigger initialized digital input pin that triggers the sampling.
+ * @param sense edge or level of the pin that triggers the sampling.
+ */
+void Adc::attachGpioTrigger(Gpio& trigger, interruptSense sense)
 {
-    if(sampleSequencer == (uint32_t)sampleSequencer::SS0)
-    {
-        for(uint32_t i = 0; i < 8; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSOP0_OFFSET)), dcOperation >> (4*i), 4*i, 1, RW);
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSDC0_OFFSET)), dcSelect >> (4*i), 4*i, 4, RW);
-        }
-    }
+    uint32_t enabled = Register::getRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCACTSS_OFFSET)), sampleSequencer, 1, RW);
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS1)
-    {
-        for(uint32_t i = 0; i < 4; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSOP1_OFFSET)), dcOperation >> (4*i), 4*i, 1, RW);
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSDC1_OFFSET)), dcSelect >> (4*i), 4*i, 4, RW);
-        }
-    }
+    sequencerTrigSrc = (uint32_t)ssTriggerSource::gpio;
+
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCACTSS_OFFSET)), (uint32_t)setORClear::clear, sampleSequencer, 1, RW);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCEMUX_OFFSET)), sequencerTrigSrc, sampleSequencer * 4, 3 + 1, RW);
+
+    trigger.enableAdcTrigger(sense);
+
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCACTSS_OFFSET)), enabled, sampleSequencer, 1, RW);
+}
+
+/**
+ * @brief Samples the sequence at a fixed rate, triggered in hardware by a 
+ *        general purpose timer.
+ * 
+ * @details Call after one of the sequencer initializations. The sequencer 
+ *          trigger is changed to \c ssTriggerSource::timer , the timer is 
+ *          set up with \c GeneralPurposeTimer::initializeForAdcTrigger and 
+ *          both are started. The sampling instants are set by the timer 
+ *          alone, so there is no software jitter. The rate is limited to 
+ *          \c getMaxSequenceRateHz , faster triggers would be dropped by the
+ *          busy converter. Any other timer with its ADC trigger output 
+ *          enabled also triggers the sequence.
+ * 
+ * @param trigger timer used to trigger the sampling.
+ * @param block of the timer used.
+ * @param sequenceRateHz sequences per second.
+ * 
+ * @return achieved sequence rate in Hz.
+ */
+uint32_t Adc::startFixedRateSampling(GeneralPurposeTimer& trigger, timerBlock block, uint32_t sequenceRateHz)
+{
+    uint32_t maxRateHz = getMaxSequenceRateHz();
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS2)
+    if(sequenceRateHz > maxRateHz)
     {
-        for(uint32_t i = 0; i < 4; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSOP2_OFFSET)), dcOperation >> (4*i), 4*i, 1, RW);
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSDC2_OFFSET)), dcSelect >> (4*i), 4*i, 4, RW);
-        }
+        sequenceRateHz = maxRateHz;
     }
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS3)
-    {
-        Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSOP3_OFFSET)), dcOperation, 0, 1, RW);
-        Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSSDC3_OFFSET)), dcSelect, 0, 4, RW);
+    sequencerTrigSrc = (uint32_t)ssTriggerSource::timer;
 
-    }
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCACTSS_OFFSET)), (uint32_t)setORClear::clear, sampleSequencer, 1, RW);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCEMUX_OFFSET)), sequencerTrigSrc, sampleSequencer * 4, 3 + 1, RW);
+
+    uint32_t achievedRateHz = trigger.initializeForAdcTrigger(block, sequenceRateHz);
+
+    enableSampleSequencer();
+    trigger.enableTimer();
+
+    return(achievedRateHz);
 }
 
+/**
+ * @brief Gets the highest rate the sequence can be triggered at.
+ * 
+ * @details The converter does 1 Msps, each step of the sequence takes one 
+ *          conversion per hardware averaged sample.
+ * 
+ * @return sequences per second.
+ */
+uint32_t Adc::getMaxSequenceRateHz(void)
+{
+    uint32_t averaging = Register::getRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCSAC_OFFSET)), 0, 2 + 1, RW);
+
+    return(maxConversionRateHz / (getSequenceLength() << averaging));
+}
+
+/**
+ * @brief Routes the steps of the sample sequence to the digital comparators.
+ * 
+ * @details ADCSSOPn and ADCSSDCn are each written with one store masked to 
+ *          the steps of the sequencer, a step with its \c ssDcOperation bit 
+ *          set goes to the comparator its \c ssDcSelect nibble names instead
+ *          of the FIFO.
+ * 
+ * @param dcOperation ORed \c ssDcOperation values, one bit per step.
+ * @param dcSelect ORed \c ssDcSelect0 to \c ssDcSelect7 values, one 
+ *        comparator per step.
+ */
+void Adc::enableSampleSequencerDc(uint32_t dcOperation, uint32_t dcSelect)
+{
+    uint32_t stepMask = getStepMask();
+
+    *((volatile uint32_t*)(baseAddress + (ADCSSOP0_OFFSET + (ssOffset * sampleSequencer)))) = dcOperation & stepMask & 0x11111111;
+    *((volatile uint32_t*)(baseAddress + (ADCSSDC0_OFFSET + (ssOffset * sampleSequencer)))) = dcSelect & stepMask;
+}
+
+/**
+ * @brief Sets up a digital comparator.
+ * 
+ * @details The comparator is reset first, so its hysteresis state starts 
+ *          over, then ADCDCCMPn and ADCDCCTLn are each written with a single
+ *          store.
+ * 
+ * @param adcModule module of the comparator, 0 or 1.
+ * @param dc comparator, 0 to 7.
+ * @param bitField \c dcControl_CIM , \c dcControl_CIC and \c dcControl_CIE 
+ *        interrupt settings and \c dcControl_CTM , \c dcControl_CTC and 
+ *        \c dcControl_CTE PWM trigger settings ORed together.
+ * @param highBand upper threshold (COMP1) between the mid and the high band, 
+ *        0 to 4095.
+ * @param lowBand lower threshold (COMP0) between the low and the mid band, 
+ *        0 to \c highBand .
+ */
 void Adc::initializeDc(uint32_t adcModule, uint32_t dc, uint32_t bitField, uint32_t highBand, uint32_t lowBand)
 {
-    uint32_t dcCtlAddress = (adc0BaseAddress + (adcModule * 0x1000) + (ADCDCCTL0_OFFSET + dc*0x4));
-    uint32_t dcCmpAddress = (adc0BaseAddress + (adcModule * 0x1000) + (ADCDCCMP0_OFFSET + dc*0x4));
+    uint32_t moduleBase = adc0BaseAddress + (adcModule * 0x1000);
 
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCtlAddress), bitField, 0, 2, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCtlAddress), bitField >> 2, 2, 2, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCtlAddress), bitField >> 4, 4, 1, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCtlAddress), bitField >> 8, 8, 2, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCtlAddress), bitField >> 10, 10, 2, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCtlAddress), bitField >> 12, 12, 1, RW);
+    resetDc(adcModule, 0x1 << dc);
 
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCmpAddress), lowBand, 0, 11 + 1, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)dcCmpAddress), highBand, 16, 27 - 16 + 1, RW);
+    *((volatile uint32_t*)(moduleBase + ADCDCCMP0_OFFSET + (dc * 0x4))) = ((highBand & 0xFFF) << 16) | (lowBand & 0xFFF);
+    *((volatile uint32_t*)(moduleBase + ADCDCCTL0_OFFSET + (dc * 0x4))) = bitField & 0x1F1F;
+}
+
+/**
+ * @brief Sets the function called when a digital comparator interrupts.
+ * 
+ * @details The handler is called from the interrupt of every sequencer that 
+ *          has \c enableDcInterrupt set, after the comparator interrupt was 
+ *          cleared.
+ * 
+ * @param adcModule module of the comparator, 0 or 1.
+ * @param dc comparator, 0 to 7.
+ * @param handler called with the module, the comparator and \c context , 0 
+ *        to remove.
+ * @param context pointer passed to the handler.
+ */
+void Adc::attachDcHandler(uint32_t adcModule, uint32_t dc, void (*handler)(uint32_t adcModule, uint32_t dc, void* context), void* context)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+
+    dcHandlerContext[adcModule][dc] = context;
+    dcHandler[adcModule][dc] = handler;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+}
+
+/**
+ * @brief Resets the interrupt and trigger conditions of digital comparators,
+ *        e.g. to re-arm a comparator in a "once" mode.
+ * 
+ * @param adcModule module of the comparators, 0 or 1.
+ * @param dcMask comparators to reset, bit n is comparator n.
+ */
+void Adc::resetDc(uint32_t adcModule, uint32_t dcMask)
+{
+    //DCRIn bits 0 to 7 reset the interrupt condition, DCTRIGn bits 16 to 23 the trigger condition
+    *((volatile uint32_t*)(adc0BaseAddress + (adcModule * 0x1000) + ADCDCRIC_OFFSET)) = (dcMask & 0xFF) | ((dcMask & 0xFF) << 16);
+}
+
+/**
+ * @brief Routes the digital comparator interrupts through this sequencer's 
+ *        interrupt (ADCIM DCONSSn) and enables it in the NVIC.
+ * 
+ * @details Call after one of the sequencer initializations. Only one 
+ *          sequencer per module needs this, every comparator of the module 
+ *          interrupts through it.
+ * 
+ * @param interruptPriority priority of the sequencer interrupt, 0 to 7.
+ */
+void Adc::enableDcInterrupt(uint32_t interruptPriority)
+{
+    *((volatile uint32_t*)(baseAddress + ADCDCISC_OFFSET)) = 0xFF;
+    *((volatile uint32_t*)(baseAddress + ADCISC_OFFSET)) = 0x1 << (16 + sampleSequencer);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCIM_OFFSET)), (uint32_t)setORClear::set, 16 + sampleSequencer, 1, RW);
+    activateSequencerInterrupt(interruptPriority);
+}
 
+/**
+ * @brief Stops routing the digital comparator interrupts through this 
+ *        sequencer's interrupt.
+ */
+void Adc::disableDcInterrupt(void)
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCIM_OFFSET)), (uint32_t)setORClear::clear, 16 + sampleSequencer, 1, RW);
 }
 
 void Adc::pollStatus(void)
@@ -245,9 +471,74 @@ uint32_t Adc::getAdcSample(void)
     return(Register::getRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSFIFO0_OFFSET + (ssOffset * sampleSequencer)))), 0, 11 + 1, RO));
 }
 
+/**
+ * @brief Drains every result waiting in the sample sequencer FIFO.
+ * 
+ * @details ADCSSFSTAT is read once and its EMPTY, FULL, head and tail fields 
+ *          give the number of waiting results, which are then read back to 
+ *          back without checking the status again. One 8-step SS0 sequence 
+ *          costs one call instead of eight \c getAdcSample calls. Results are
+ *          in the order they were converted.
+ * 
+ * @param buffer where the 12-bit results are stored.
+ * @param maxSamples size of \c buffer , results past it stay in the FIFO.
+ * 
+ * @return number of results read.
+ */
+uint32_t Adc::readInto(uint16_t* buffer, uint32_t maxSamples)
+{
+    volatile uint32_t* fifo = (volatile uint32_t*)(baseAddress + (ADCSSFIFO0_OFFSET + (ssOffset * sampleSequencer)));
+    uint32_t pending = getFifoLevel();
+    adcStatistics& counters = statistics[adcModule][sampleSequencer];
+
+    if(pending > counters.fifoHighWater)
+    {
+        counters.fifoHighWater = pending;
+    }
+
+    if(pending > maxSamples)
+    {
+        pending = maxSamples;
+    }
+
+    for(uint32_t i = 0; i < pending; i++)
+    {
+        buffer[i] = (uint16_t)(*fifo & 0xFFF);
+    }
+
+    return(pending);
+}
+
+/**
+ * @brief Gets the number of results waiting in the sample sequencer FIFO 
+ *        from a single ADCSSFSTAT read.
+ * 
+ * @return 0 up to the FIFO depth.
+ */
+uint32_t Adc::getFifoLevel(void)
+{
+    uint32_t status = *((volatile uint32_t*)(baseAddress + (ADCSSFSTAT0_OFFSET + (ssOffset * sampleSequencer))));
+
+    //FIFO depth is 8 for SS0, 4 for SS1 and SS2 and 1 for SS3
+    uint32_t depth = (sampleSequencer == (uint32_t)sampleSequencer::SS0) ? 8 : ((sampleSequencer == (uint32_t)sampleSequencer::SS3) ? 1 : 4);
+
+    if(((status >> 8) & 0x1) != 0)
+    {
+        return(0);
+    }
+
+    else if(((status >> 12) & 0x1) != 0)
+    {
+        return(depth);
+    }
+
+    return((((status >> 4) & 0xF) - (status & 0xF)) & (depth - 1));
+}
+
 void Adc::clearInterrupt(void)
 {
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCISC_OFFSET)), (uint32_t)setORClear::set, sampleSequencer, 1, RW1C);
+    //ADCISC is write 1 to clear, a read-modify-write would clear the other sequencers too
+    *((volatile uint32_t*)(baseAddress + ADCISC_OFFSET)) = 0x1 << sampleSequencer;
 }
 
 uint32_t Adc::getDcInterruptStatus(uint32_t adcModule, uint32_t digitalComparator)
@@ -257,15 +548,328 @@ uint32_t Adc::getDcInterruptStatus(uint32_t adcModule, uint32_t digitalComparato
 
 void Adc::clearDcInterrupt(uint32_t adcModule, uint32_t digitalComparator)
 {
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(adc0BaseAddress + (adcModule * 0x1000) + ADCDCISC_OFFSET)), (uint32_t)setORClear::set , digitalComparator, 1, RW1C);
+    *((volatile uint32_t*)(adc0BaseAddress + (adcModule * 0x1000) + ADCDCISC_OFFSET)) = 0x1 << digitalComparator;
+}
+
+/**
+ * @brief Services the stream, called from the sample sequencer interrupt 
+ *        handler.
+ * 
+ * @details Re-arms every completed half before calling \c blockReady , so 
+ *          μDMA never waits on the callback. A callback that takes longer 
+ *          than filling one half causes overruns.
+ */
+void Adc::serviceStream(void)
+{
+    Dma::clearChannelInterrupt(dmaChannel);
+
+    bool stopped = !Dma::isChannelEnabled(dmaChannel);
+    bool firstBlockAlternate = nextBlockAlternate;
+    uint32_t readyBlocks = 0;
+
+    while((readyBlocks < 2) && (Dma::getMode(dmaChannel, nextBlockAlternate) == dmaMode::stop))
+    {
+        armStreamBlock(nextBlockAlternate);
+        nextBlockAlternate = !nextBlockAlternate;
+        readyBlocks++;
+    }
+
+    if(stopped == true)
+    {
+        //Both halves filled before this handler ran, the FIFO overflowed
+        *((volatile uint32_t*)(baseAddress + ADCOSTAT_OFFSET)) = 0x1 << sampleSequencer;
+        streamOverrunCount++;
+        Dma::enableChannel(dmaChannel);
+    }
+
+    for(uint32_t i = 0; i < readyBlocks; i++)
+    {
+        streamBlockCount++;
+
+        if(blockReady != 0)
+        {
+            blockReady(streamBuffer + (firstBlockAlternate ? streamBlockLength : 0), streamBlockLength, blockReadyContext);
+        }
+
+        firstBlockAlternate = !firstBlockAlternate;
+    }
+}
+
+/**
+ * @brief Stops the sample sequencer and its μDMA channel.
+ */
+void Adc::stopStreaming(void)
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCACTSS_OFFSET)), (uint32_t)setORClear::clear, sampleSequencer, 1, RW);
+    Dma::disableChannel(dmaChannel);
+}
+
+/**
+ * @brief Gets the number of half buffers delivered since 
+ *        \c initializeForStreaming , for measuring the sustained rate.
+ * 
+ * @return completed half buffer count.
+ */
+uint32_t Adc::getStreamBlockCount(void)
+{
+    return(streamBlockCount);
+}
+
+/**
+ * @brief Gets the number of times the stream stopped because both halves 
+ *        filled before \c serviceStream ran.
+ * 
+ * @return overrun count.
+ */
+uint32_t Adc::getStreamOverrunCount(void)
+{
+    return(streamOverrunCount);
+}
+
+/**
+ * @brief Dispatches a sample sequencer interrupt to the Adc object that owns
+ *        the sequencer.
+ * 
+ * @details Digital comparator interrupts routed to the sequencer are handled
+ *          first: ADCDCISC is read once, cleared with a single store and the
+ *          handler of each comparator that interrupted is called. The
+ *          overflow and underflow flags of the sequencer are counted and 
+ *          cleared, see \c recordFifoStatus . Then a streaming sequencer 
+ *          is serviced with \c serviceStream . Otherwise a pending sequencer
+ *          interrupt is cleared with a single ADCISC store, and if the owner
+ *          has a callback the FIFO is drained into a buffer on the stack and
+ *          handed to it. Without a callback the samples are left in the FIFO.
+ * 
+ * @param adcModule module that interrupted, 0 or 1.
+ * @param sampleSequencer sequencer that interrupted, 0 to 3.
+ */
+void Adc::dispatchInterrupt(uint32_t adcModule, uint32_t sampleSequencer)
+{
+    uint32_t moduleBase = adc0BaseAddress + (adcModule * 0x1000);
+    uint32_t status = *((volatile uint32_t*)(moduleBase + ADCISC_OFFSET));
+
+    if((status & (0x1 << (16 + sampleSequencer))) != 0)
+    {
+        uint32_t pending = *((volatile uint32_t*)(moduleBase + ADCDCISC_OFFSET));
+
+        *((volatile uint32_t*)(moduleBase + ADCDCISC_OFFSET)) = pending;
+        *((volatile uint32_t*)(moduleBase + ADCISC_OFFSET)) = 0x1 << (16 + sampleSequencer);
+
+        while(pending != 0)
+        {
+            uint32_t dc = 31 - __builtin_clz(pending);
+            pending &= ~(0x1 << dc);
+
+            if(dcHandler[adcModule][dc] != 0)
+            {
+                dcHandler[adcModule][dc](adcModule, dc, dcHandlerContext[adcModule][dc]);
+            }
+        }
+    }
+
+    Adc* owner = interruptOwner[adcModule][sampleSequencer];
+
+    recordFifoStatus(adcModule, sampleSequencer);
+    statistics[adcModule][sampleSequencer].interruptCount++;
+
+    if((owner != 0) && ((*owner).streamBuffer != 0))
+    {
+        uint32_t level = (*owner).getFifoLevel();
+
+        if(level > statistics[adcModule][sampleSequencer].fifoHighWater)
+        {
+            statistics[adcModule][sampleSequencer].fifoHighWater = level;
+        }
+
+        (*owner).serviceStream();
+        return;
+    }
+
+    if((status & (0x1 << sampleSequencer)) == 0)
+    {
+        return;
+    }
+
+    *((volatile uint32_t*)(moduleBase + ADCISC_OFFSET)) = 0x1 << sampleSequencer;
+
+    if((owner != 0) && ((*owner).sampled != 0))
+    {
+        uint16_t samples[8];
+        uint32_t count = (*owner).readInto(samples, 8);
+
+        (*owner).sampled(samples, count, (*owner).sampledContext);
+    }
+}
+
+/**
+ * @brief Counts and clears the overflow and underflow flags of a sequencer.
+ * 
+ * @details ADCOSTAT and ADCUSTAT hold one sticky flag per sequencer, each is 
+ *          read once and a set flag is cleared with a single write 1 to clear
+ *          store of its own bit, so the other sequencers keep theirs. A flag 
+ *          counts once however many results were lost while it was set, so 
+ *          the counters are a lower bound that grows with how often the 
+ *          sequencer falls behind.
+ * 
+ * @param adcModule module, 0 or 1.
+ * @param sampleSequencer sequencer, 0 to 3.
+ */
+void Adc::recordFifoStatus(uint32_t adcModule, uint32_t sampleSequencer)
+{
+    uint32_t moduleBase = adc0BaseAddress + (adcModule * 0x1000);
+    uint32_t mask = 0x1 << sampleSequencer;
+
+    if((*((volatile uint32_t*)(moduleBase + ADCOSTAT_OFFSET)) & mask) != 0)
+    {
+        *((volatile uint32_t*)(moduleBase + ADCOSTAT_OFFSET)) = mask;
+        statistics[adcModule][sampleSequencer].overflowCount++;
+    }
+
+    if((*((volatile uint32_t*)(moduleBase + ADCUSTAT_OFFSET)) & mask) != 0)
+    {
+        *((volatile uint32_t*)(moduleBase + ADCUSTAT_OFFSET)) = mask;
+        statistics[adcModule][sampleSequencer].underflowCount++;
+    }
 }
 
+/**
+ * @brief Collects the overflow, underflow and FIFO level of the sequencer 
+ *        when it is polled instead of serviced by interrupts.
+ */
+void Adc::updateStatistics(void)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+    uint32_t level = getFifoLevel();
+
+    recordFifoStatus(adcModule, sampleSequencer);
+
+    if(level > statistics[adcModule][sampleSequencer].fifoHighWater)
+    {
+        statistics[adcModule][sampleSequencer].fifoHighWater = level;
+    }
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+}
+
+/**
+ * @brief Gets a consistent copy of the health counters of the sequencer.
+ * 
+ * @details Counters are collected by the interrupt dispatcher, by 
+ *          \c readInto and by \c updateStatistics . A rising overflow count
+ *          means results are being lost, a high water mark at the FIFO depth 
+ *          means the sequencer is close to it.
+ * 
+ * @return counters since the last \c resetStatistics .
+ */
+adcStatistics Adc::getStatistics(void)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+    adcStatistics copy = statistics[adcModule][sampleSequencer];
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    return(copy);
+}
+
+/**
+ * @brief Clears the health counters of the sequencer.
+ */
+void Adc::resetStatistics(void)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+
+    statistics[adcModule][sampleSequencer] = adcStatistics();
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+}
+
+/**
+ * @brief Gets the resolution of the converter.
+ * 
+ * @details Read from ADCPP once by initializeModule, so calling this in a 
+ *          sample loop costs no peripheral access. Before any module is 
+ *          initialized ADCPP of module 0 is read, which needs its clock.
+ * 
+ * @return bits per sample.
+ */
 uint32_t Adc::getAdcResolution()
 {
-    return(Register::getRegisterBitFieldStatus(((volatile uint32_t*)(adc0BaseAddress + ADCPP_OFFSET)), 18, 22 - 18 + 1, RO));
+    if(resolution == 0)
+    {
+        resolution = Register::getRegisterBitFieldStatus(((volatile uint32_t*)(adc0BaseAddress + ADCPP_OFFSET)), 18, 22 - 18 + 1, RO);
+    }
+
+    return(resolution);
 }
 
 
+/**
+ * @brief Enables the NVIC interrupt of the sample sequencer.
+ * 
+ * @param interruptPriority 0 to 7.
+ */
+void Adc::activateSequencerInterrupt(uint32_t interruptPriority)
+{
+    if(adcModule == (uint32_t)adcModule::module0)
+    {
+        switch (sampleSequencer)
+        {
+            case (uint32_t)sampleSequencer::SS0:
+                Nvic::activateInterrupt(ADC_0_Sequence_0_Interrupt, interruptPriority);
+                break;
+
+            case (uint32_t)sampleSequencer::SS1:
+                Nvic::activateInterrupt(ADC_0_Sequence_1_Interrupt, interruptPriority);
+                break;
+
+            case (uint32_t)sampleSequencer::SS2:
+                Nvic::activateInterrupt(ADC_0_Sequence_2_Interrupt, interruptPriority);
+                break;
+
+            case (uint32_t)sampleSequencer::SS3:
+                Nvic::activateInterrupt(ADC_0_Sequence_3_Interrupt, interruptPriority);
+                break;
+            
+            default:
+                break;
+        }
+    }
+
+    else
+    {
+        switch (sampleSequencer)
+        {
+            case (uint32_t)sampleSequencer::SS0:
+                Nvic::activateInterrupt(ADC_1_Sequence_0_Interrupt, interruptPriority);
+                break;
+
+            case (uint32_t)sampleSequencer::SS1:
+                Nvic::activateInterrupt(ADC_1_Sequence_1_Interrupt, interruptPriority);
+                break;
+
+            case (uint32_t)sampleSequencer::SS2:
+                Nvic::activateInterrupt(ADC_1_Sequence_2_Interrupt, interruptPriority);
+                break;
+
+            case (uint32_t)sampleSequencer::SS3:
+                Nvic::activateInterrupt(ADC_1_Sequence_3_Interrupt, interruptPriority);
+                break;
+            
+            default:
+                break;
+        }
+    }
+}
+
 /**
  * @brief initialize the Sample Sequencer
  * @details Sample Sequencer Configuration:
@@ -307,38 +911,14 @@ void Adc::initialization(void)
     //2. Configure the trigger event for the sample sequencer in the ADCEMUX register.
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + ADCEMUX_OFFSET)), sequencerTrigSrc, sampleSequencer * 4, 3 + 1, RW);
 
-    //3. For each sample in the sample sequence, configure the corresponding input source in the ADCSSMUXn register.
-    if(sampleSequencer == (uint32_t)sampleSequencer::SS0)
-    {
-        for(int i = 0; i < 8; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSMUX0_OFFSET + (ssOffset * sampleSequencer)))), inputSource >> (i * 4), i * 4, 3 + 1, RW);
-        }
-    }
-
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS1)
-    {
-        for(int i = 0; i < 4; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSMUX0_OFFSET + (ssOffset * sampleSequencer)))), inputSource >> (i * 4), i * 4, 3 + 1, RW);
-        }
-    }
-
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS2)
-    {
-        for(int i = 0; i < 4; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSMUX0_OFFSET + (ssOffset * sampleSequencer)))), inputSource >> (i * 4), i * 4, 3 + 1, RW);
-        }
-    }
+    uint32_t stepMask = getStepMask();
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS3)
-    {
-        for(int i = 0; i < 1; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSMUX0_OFFSET + (ssOffset * sampleSequencer)))), inputSource >> (i * 4), i * 4, 3 + 1, RW);
-        }
-    }
+    /*
+     * 3. For each sample in the sample sequence, configure the corresponding 
+     * input source in the ADCSSMUXn register. Every step is written with one
+     * store, a field by field write would drop the nibbles above the first.
+     */
+    *((volatile uint32_t*)(baseAddress + (ADCSSMUX0_OFFSET + (ssOffset * sampleSequencer)))) = inputSource & stepMask;
 
     /*
      * 4. For each sample in the sample sequence, configure the sample control 
@@ -346,36 +926,98 @@ void Adc::initialization(void)
      * programming the last nibble, ensure that the END bit is set. Failure to 
      * set the END bit causes unpredictable behavior.
      */
+    *((volatile uint32_t*)(baseAddress + (ADCSSCTL0_OFFSET + (ssOffset * sampleSequencer)))) = sequencerControl & stepMask;
+
+}
+
+/**
+ * @brief Points one ping-pong control structure at its half of the stream 
+ *        buffer.
+ * 
+ * @param alternate true for the second half and the alternate structure.
+ */
+void Adc::armStreamBlock(bool alternate)
+{
+    uint16_t* blockEnd = streamBuffer + (alternate ? streamBlockLength : 0) + (streamBlockLength - 1);
+
+    Dma::setTransfer(dmaChannel, alternate, ((volatile uint32_t*)(baseAddress + (ADCSSFIFO0_OFFSET + (ssOffset * sampleSequencer)))), blockEnd, streamControl);
+}
+
+/**
+ * @brief Gets the nibbles of the per step registers (ADCSSMUXn, ADCSSCTLn, 
+ *        ADCSSOPn, ADCSSDCn) the sequencer has.
+ * 
+ * @return 8 nibbles for SS0, 4 for SS1 and SS2 and 1 for SS3.
+ */
+uint32_t Adc::getStepMask(void)
+{
     if(sampleSequencer == (uint32_t)sampleSequencer::SS0)
     {
-        for(int i = 0; i < 32; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSCTL0_OFFSET + (ssOffset * sampleSequencer)))), sequencerControl >> i, i, 1, RW);
-        }
+        return(0xFFFFFFFF);
     }
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS1)
+    else if(sampleSequencer == (uint32_t)sampleSequencer::SS3)
     {
-        for(int i = 0; i < 16; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSCTL0_OFFSET + (ssOffset * sampleSequencer)))), sequencerControl >> i, i, 1, RW);
-        }
+        return(0xF);
     }
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS2)
-    {
-        for(int i = 0; i < 16; i++)
-        {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSCTL0_OFFSET + (ssOffset * sampleSequencer)))), sequencerControl >> i, i, 1, RW);
-        }
-    }
+    return(0xFFFF);
+}
 
-    else if(sampleSequencer == (uint32_t)sampleSequencer::SS3)
+/**
+ * @brief Gets the number of steps of the sequence, from its END bit.
+ * 
+ * @return 1 to 8.
+ */
+uint32_t Adc::getSequenceLength(void)
+{
+    for(uint32_t i = 0; i < 8; i++)
     {
-        for(int i = 0; i < 4; i++)
+        if(((sequencerControl >> (4 * i + 1)) & 0x1) != 0)
         {
-            Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + (ADCSSCTL0_OFFSET + (ssOffset * sampleSequencer)))), sequencerControl >> i, i, 1, RW);
+            return(i + 1);
         }
     }
 
-}
\ No newline at end of file
+    return(1);
+}
+
+extern "C" void ADC_0_Sequence_0_Handler(void)
+{
+    Adc::dispatchInterrupt(0, 0);
+}
+
+extern "C" void ADC_0_Sequence_1_Handler(void)
+{
+    Adc::dispatchInterrupt(0, 1);
+}
+
+extern "C" void ADC_0_Sequence_2_Handler(void)
+{
+    Adc::dispatchInterrupt(0, 2);
+}
+
+extern "C" void ADC_0_Sequence_3_Handler(void)
+{
+    Adc::dispatchInterrupt(0, 3);
+}
+
+extern "C" void ADC_1_Sequence_0_Handler(void)
+{
+    Adc::dispatchInterrupt(1, 0);
+}
+
+extern "C" void ADC_1_Sequence_1_Handler(void)
+{
+    Adc::dispatchInterrupt(1, 1);
+}
+
+extern "C" void ADC_1_Sequence_2_Handler(void)
+{
+    Adc::dispatchInterrupt(1, 2);
+}
+
+extern "C" void ADC_1_Sequence_3_Handler(void)
+{
+    Adc::dispatchInterrupt(1, 3);
+}
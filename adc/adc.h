@@ -80,12 +80,89 @@
  * programmed (see page 352). There must be a delay of 3 system clocks after the 
  * ADC module clock is enabled before any ADC module registers are accessed.
  * 
+ * @subsection adcStreamingDescription ADC Streaming
+ * 
+ * \c initializeForStreaming moves the results of a sample sequencer into a 
+ * buffer in SRAM with the sequencer's μDMA channel in ping-pong mode, so no
+ * processor work is done per sample. The buffer is split in two halves, while
+ * μDMA fills one half the other is handed to the \c blockReady callback. The 
+ * sequencer interrupt fires once per half, its handler calls 
+ * \c serviceStream , which re-arms the completed half and then calls 
+ * \c blockReady from the interrupt.
+ * 
+ * If both halves fill before \c serviceStream runs, μDMA stops and the 
+ * sequencer FIFO overflows; \c serviceStream restarts the stream and counts
+ * an overrun. \c getStreamBlockCount and \c getStreamOverrunCount give the 
+ * achieved rate and the losses.
+ * 
+ * Example:
+ * @code
+ * uint16_t samples[512];
+ * 
+ * adc.initializeModule((uint32_t)adcModule::module0, sequencerPriority, 0, 0);
+ * adc.initializeForStreaming((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::continousSampling, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, samples, 512, process, 0, 2);
+ * adc.enableSampleSequencer();
+ * @endcode
+ * 
+ * @subsection adcInterruptDescription ADC Interrupts
+ * 
+ * The driver defines the handlers of the 8 sample sequencer interrupts. Each 
+ * one dispatches to the Adc object that last initialized that sequencer for 
+ * interrupts or streaming. For a sequencer initialized with a callback the 
+ * handler clears the interrupt with a single ADCISC store, drains the FIFO 
+ * and calls the callback with the samples and its context pointer.
+ * 
+ * Example:
+ * @code
+ * void sampled(uint16_t* samples, uint32_t count, void* context)
+ * {
+ *     *((volatile uint32_t*)context) = samples[count - 1];
+ * }
+ * 
+ * adc.initializeForInterrupt((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::processor, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, sampled, &lastSample, 4);
+ * adc.enableSampleSequencer();
+ * adc.initiateSampling();
+ * @endcode
+ * 
+ * @subsection adcDigitalComparatorDescription ADC Digital Comparators
+ * 
+ * Each module has 8 digital comparators that check sequencer results against
+ * a low and a high band threshold in hardware. \c initializeDc sets the 
+ * thresholds, the interrupt mode (always, once, hysteresis always or 
+ * hysteresis once) and the band that interrupts. \c enableSampleSequencerDc 
+ * sends sequence steps to comparators, with the S*DCOP bits set the results 
+ * only go to the comparator and are not stored in the FIFO. 
+ * \c enableDcInterrupt routes the comparator interrupts through the 
+ * sequencer's interrupt, where the driver calls the handler attached to each
+ * comparator with \c attachDcHandler . 
+ * 
+ * Together this lets the processor sleep while a timer triggered sequence 
+ * watches a signal and wakes it only when the signal leaves its band. In the
+ * hysteresis modes the comparator interrupts when the signal enters the 
+ * selected band and re-arms only once it has reached the opposite band, so a
+ * noisy signal near a threshold does not interrupt repeatedly.
+ * 
+ * Example, interrupt once each time AIN0 rises above 3000 after having been 
+ * below 1000:
+ * @code
+ * Adc::initializeDc((uint32_t)adcModule::module0, 0, (uint32_t)dcControl_CIM::hysteresisOnce|(uint32_t)dcControl_CIC::highBand|(uint32_t)dcControl_CIE::enable, 3000, 1000);
+ * Adc::attachDcHandler((uint32_t)adcModule::module0, 0, overThreshold, 0);
+ * 
+ * adc.initializeForPolling((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::timer, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0, 0);
+ * adc.enableSampleSequencerDc((uint32_t)ssDcOperation::S0DCOP, (uint32_t)ssDcSelect0::dc0);
+ * adc.enableDcInterrupt(4);
+ * adc.startFixedRateSampling(trigger, shortTimer1, 1000);
+ * @endcode
+ * 
  */
 
 #ifndef ADC_H
 #define ADC_H
 
 #include "../systemControl/systemControl.h"
+#include "../gpio/gpio.h"
+#include "../udma/udma.h"
+#include "../timer/generalPurposeTimer.h"
 
 enum class adcModule : uint32_t{module0, module1};
 
@@ -141,24 +218,48 @@ enum class dcControl_CIM : uint32_t{always, once, hysteresisAlways, hysteresisOn
 enum class dcControl_CIC : uint32_t{lowBand = 0x0 << 2, midBand = 0x1 << 2, highBand = 0x3 << 2};
 enum class dcControl_CIE : uint32_t{disable = ((uint32_t)setORClear::clear) << 4, enable = ((uint32_t)setORClear::set) << 4};
 enum class dcControl_CTM : uint32_t{always = 0x0 << 8, once = 0x1 << 8, hysteresisAlways = 0x2 << 8, hysteresisOnce = 0x3 << 8};
-enum class dcControl_CTC : uint32_t{owBand = 0x0 << 10, midBand = 0x1 << 10, highBand = 0x3 << 10};
+enum class dcControl_CTC : uint32_t{lowBand = 0x0 << 10, midBand = 0x1 << 10, highBand = 0x3 << 10};
 enum class dcControl_CTE : uint32_t{disable = ((uint32_t)setORClear::clear) << 12, enable = ((uint32_t)setORClear::set) << 12};
 
+/**
+ * @brief Health counters of one sample sequencer, see Adc::getStatistics.
+ */
+struct adcStatistics
+{
+    uint32_t overflowCount;   //Results dropped because the FIFO was full (ADCOSTAT)
+    uint32_t underflowCount;  //Reads of an empty FIFO (ADCUSTAT)
+    uint32_t fifoHighWater;   //Most results seen waiting in the FIFO
+    uint32_t interruptCount;  //Sequencer interrupts serviced
+};
+
 
 class Adc
 {
     public:
         Adc();
         ~Adc();
+        Adc(const Adc&) = delete;
+        Adc& operator=(const Adc&) = delete;
 
         void initializeModule(uint32_t adcModule, uint32_t sequencerPriority, uint32_t hardwareAveraging, uint32_t phaseDelay);
+        void acquireModule(uint32_t adcModule);
 
         void initializeForPolling(uint32_t sampleSequencer, uint32_t sequencerTrigSrc, uint32_t inputSource, uint32_t sequencerControl, void (*action)(void));
         void initializeForInterrupt(uint32_t sampleSequencer, uint32_t sequencerTrigSrc, uint32_t inputSource, uint32_t sequencerControl, uint32_t interruptPriority);
+        void initializeForInterrupt(uint32_t sampleSequencer, uint32_t sequencerTrigSrc, uint32_t inputSource, uint32_t sequencerControl, void (*sampled)(uint16_t* samples, uint32_t count, void* context), void* context, uint32_t interruptPriority);
+        void initializeForStreaming(uint32_t sampleSequencer, uint32_t sequencerTrigSrc, uint32_t inputSource, uint32_t sequencerControl, uint16_t* buffer, uint32_t bufferLength, void (*blockReady)(uint16_t* samples, uint32_t count, void* context), void* context, uint32_t interruptPriority);
         void enableSampleSequencer(void);
+        void attachGpioTrigger(Gpio& trigger, interruptSense sense);
+        uint32_t startFixedRateSampling(GeneralPurposeTimer& trigger, timerBlock block, uint32_t sequenceRateHz);
+        uint32_t getMaxSequenceRateHz(void);
         void enableSampleSequencerDc(uint32_t dcOperation, uint32_t dcSelect);
 
+        void enableDcInterrupt(uint32_t interruptPriority);
+        void disableDcInterrupt(void);
+
         static void initializeDc(uint32_t adcModule, uint32_t dc, uint32_t bitField, uint32_t highBand, uint32_t lowBand);
+        static void attachDcHandler(uint32_t adcModule, uint32_t dc, void (*handler)(uint32_t adcModule, uint32_t dc, void* context), void* context);
+        static void resetDc(uint32_t adcModule, uint32_t dcMask);
 
         void pollStatus(void);
         void pollDigitalComparator(void);
@@ -166,7 +267,13 @@ class Adc
 
         void initiateSampling(void);
 
+        void serviceStream(void);
+        void stopStreaming(void);
+        uint32_t getStreamBlockCount(void);
+        uint32_t getStreamOverrunCount(void);
+
         uint32_t getAdcSample(void);
+        uint32_t readInto(uint16_t* buffer, uint32_t maxSamples);
         void clearInterrupt(void);
 
         static uint32_t getDcInterruptStatus(uint32_t adcModule, uint32_t digitalComparator);
@@ -174,14 +281,46 @@ class Adc
 
         static uint32_t getAdcResolution();
 
+        void updateStatistics(void);
+        adcStatistics getStatistics(void);
+        void resetStatistics(void);
+
+        static void dispatchInterrupt(uint32_t adcModule, uint32_t sampleSequencer);
+
     private:
 
         void initialization(void);
+        void activateSequencerInterrupt(uint32_t interruptPriority);
+        void armStreamBlock(bool alternate);
+        uint32_t getSequenceLength(void);
+        uint32_t getStepMask(void);
+        uint32_t getFifoLevel(void);
+        static void recordFifoStatus(uint32_t adcModule, uint32_t sampleSequencer);
 
         void (*action)(void);
 
+        void (*sampled)(uint16_t* samples, uint32_t count, void* context);
+        void* sampledContext;
+
+        static Adc* interruptOwner[2][4];
+        static void (*dcHandler[2][8])(uint32_t adcModule, uint32_t dc, void* context);
+        static void* dcHandlerContext[2][8];
+        static uint32_t resolution;
+        static adcStatistics statistics[2][4];
+
+        void (*blockReady)(uint16_t* samples, uint32_t count, void* context);
+        void* blockReadyContext;
+        uint16_t* streamBuffer;
+        uint32_t streamBlockLength;
+        uint32_t streamControl;
+        uint32_t dmaChannel;
+        bool nextBlockAlternate;
+        volatile uint32_t streamBlockCount;
+        volatile uint32_t streamOverrunCount;
+
         uint32_t baseAddress;
         uint32_t adcModule;
+        bool clockAcquired;
         uint32_t sampleSequencer;
         uint32_t sequencerPriority;
         uint32_t sequencerTrigSrc;
@@ -189,6 +328,7 @@ class Adc
         uint32_t sequencerControl;
 
         static const uint32_t ssOffset = 0x20;
+        static const uint32_t maxConversionRateHz = 1000000;
 
         static const uint32_t adc0BaseAddress = 0x40038000; // ADC block 0 base address
         static const uint32_t adc1BaseAddress = 0x40039000; // ADC block 1 base address
@@ -0,0 +1,171 @@
+/**
+ * @file adcCalibration.cpp
+ * @brief TM4C123GH6PM ADC Calibration Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "adcCalibration.h"
+#include "adc.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+AdcCalibration::AdcCalibration()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+AdcCalibration::~AdcCalibration()
+{
+
+}
+
+/**
+ * @brief Sets up a linear conversion and removes any table.
+ * 
+ * @param unitsFullScale units of a full scale count, 3300 for millivolts 
+ *        with a 3.3V reference.
+ * @param offsetCounts count read with a zero input.
+ * @param gainQ16 gain correction, 65536 is 1.0.
+ */
+void AdcCalibration::initialize(int32_t unitsFullScale, int32_t offsetCounts, uint32_t gainQ16)
+{
+    resolution = Adc::getAdcResolution();
+    offset = offsetCounts;
+    scale = (int32_t)(((int64_t)unitsFullScale * gainQ16) >> resolution);
+    table = 0;
+    segmentShift = 0;
+}
+
+/**
+ * @brief Replaces the linear scaling with a piecewise linear table.
+ * 
+ * @param points 2^log2Segments + 1 values in units, the first at corrected 
+ *        count 0 and the last at 2^resolution counts, 0 goes back to linear 
+ *        scaling. The table is not copied.
+ * @param log2Segments 0 up to the converter resolution.
+ */
+void AdcCalibration::setTable(const int32_t* points, uint32_t log2Segments)
+{
+    if(log2Segments > resolution)
+    {
+        log2Segments = resolution;
+    }
+
+    segmentShift = resolution - log2Segments;
+    table = points;
+}
+
+/**
+ * @brief Converts a single sample.
+ * 
+ * @param raw ADC count.
+ * 
+ * @return value in units.
+ */
+int32_t AdcCalibration::convert(uint32_t raw)
+{
+    int32_t corrected = (int32_t)raw - offset;
+
+    if(table != 0)
+    {
+        return(interpolate(corrected));
+    }
+
+    return((int32_t)(((int64_t)corrected * scale) >> 16));
+}
+
+/**
+ * @brief Converts a block of samples, two per step when no table is set.
+ * 
+ * @param raw ADC counts.
+ * @param units output, \c count values.
+ * @param count number of samples.
+ */
+void AdcCalibration::convertBlock(const uint16_t* raw, int32_t* units, uint32_t count)
+{
+    uint32_t i = 0;
+
+    if(table == 0)
+    {
+        uint32_t offsetPair = (uint32_t)(uint16_t)offset * 0x10001;
+
+        for(; (i + 1) < count; i += 2)
+        {
+            uint32_t corrected = Dsp::subtractPair(Dsp::loadPair((const q15_t*)&raw[i]), offsetPair);
+
+            units[i] = Dsp::multiplyWord(scale, corrected, false);
+            units[i + 1] = Dsp::multiplyWord(scale, corrected, true);
+        }
+    }
+
+    for(; i < count; i++)
+    {
+        units[i] = convert(raw[i]);
+    }
+}
+
+/**
+ * @brief Gets the resolution cached at initialization.
+ * 
+ * @return bits per sample.
+ */
+uint32_t AdcCalibration::getResolution(void)
+{
+    return(resolution);
+}
+
+/**
+ * @brief Table lookup with linear interpolation between the two nearest 
+ *        points.
+ * 
+ * @param corrected count after the offset.
+ * 
+ * @return value in units.
+ */
+int32_t AdcCalibration::interpolate(int32_t corrected)
+{
+    int32_t fullScale = (0x1 << resolution) - 1;
+
+    if(corrected < 0)
+    {
+        corrected = 0;
+    }
+
+    else if(corrected > fullScale)
+    {
+        corrected = fullScale;
+    }
+
+    uint32_t segment = (uint32_t)corrected >> segmentShift;
+    int32_t fraction = corrected & ((0x1 << segmentShift) - 1);
+    int32_t start = table[segment];
+    int32_t span = table[segment + 1] - start;
+
+    return(start + (int32_t)(((int64_t)span * fraction) >> segmentShift));
+}
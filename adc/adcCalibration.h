@@ -0,0 +1,90 @@
+/**
+ * @file adcCalibration.h
+ * @brief TM4C123GH6PM ADC Calibration Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class AdcCalibration
+ * @brief TM4C123GH6PM ADC Calibrated Unit Conversion
+ * 
+ * @section adcCalibrationDescription ADC Calibration Description
+ * 
+ * Converts raw ADC counts of one channel to millivolts or engineering units
+ * in integer arithmetic. One object is kept per channel.
+ * 
+ * The offset, in counts, is subtracted first. The corrected count is then 
+ * either scaled linearly or looked up in an optional piecewise linear table:
+ *      - Linear, units = ((raw - offset) * scale) >> 16, where scale is the 
+ *        Q16 units per count worked out once from the full scale units, the 
+ *        gain and the converter resolution. The result is rounded down.
+ *      - Table, 2^n + 1 points in units equally spaced over the corrected 
+ *        counts 0 to 2^resolution, interpolated linearly between points. Out of 
+ *        range counts are clamped. The gain is not used.
+ * 
+ * The resolution is read once at initialization, see 
+ * Adc::getAdcResolution. Blocks are converted two samples at a time with 
+ * the DSP extension instructions SSUB16 and SMULWB/SMULWT, which gives the 
+ * same results as the single sample conversion. Raw counts and the offset 
+ * have to fit 16-bit signed halfwords, which 12-bit results always do.
+ * 
+ * Example, AIN0 in millivolts with a 3.3V reference and a measured offset of
+ * 3 counts:
+ * @code
+ * ain0.initialize(3300, 3, 65536);
+ * milliVolts = ain0.convert(sample);
+ * @endcode
+ */
+
+#ifndef ADC_CALIBRATION_H
+#define ADC_CALIBRATION_H
+
+#include <stdint.h>
+#include "../dsp/dsp.h"
+
+class AdcCalibration
+{
+    public:
+        AdcCalibration();
+        ~AdcCalibration();
+
+        void initialize(int32_t unitsFullScale, int32_t offsetCounts, uint32_t gainQ16);
+        void setTable(const int32_t* points, uint32_t log2Segments);
+        int32_t convert(uint32_t raw);
+        void convertBlock(const uint16_t* raw, int32_t* units, uint32_t count);
+        uint32_t getResolution(void);
+
+    private:
+
+        int32_t interpolate(int32_t corrected);
+
+        uint32_t resolution;
+        int32_t offset;
+        int32_t scale;
+        const int32_t* table;
+        uint32_t segmentShift;
+};
+
+#endif //ADC_CALIBRATION_H
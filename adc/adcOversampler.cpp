@@ -0,0 +1,216 @@
+/**
+ * @file adcOversampler.cpp
+ * @brief TM4C123GH6PM ADC Oversampler Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "adcOversampler.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+AdcOversampler::AdcOversampler()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+AdcOversampler::~AdcOversampler()
+{
+
+}
+
+/**
+ * @brief Sets up sample sequencer 0 of the ADC module and the trigger timer 
+ *        and starts oversampling.
+ * 
+ * @param adcModule module to use, sample sequencer 0 of it is used.
+ * @param inputSource input to oversample, a \c ssInputSrc0 value.
+ * @param extraBits bits of resolution to add, 2 to 4, each one costs 4 times
+ *        the results per output. Values outside are clamped.
+ * @param outputRateHz outputs per second.
+ * @param trigger timer used to trigger the sequencer.
+ * @param block of the timer used.
+ * @param result called from the interrupt with every output and 
+ *        \c context , may be 0.
+ * @param context pointer passed to \c result .
+ * @param interruptPriority priority of the sequencer interrupt, 0 to 7.
+ * 
+ * @return achieved output rate in Hz, lower than requested if the converter
+ *         cannot keep up.
+ */
+uint32_t AdcOversampler::initialize(uint32_t adcModule, uint32_t inputSource, uint32_t extraBits, uint32_t outputRateHz, GeneralPurposeTimer& trigger, timerBlock block, void (*result)(uint32_t value, void* context), void* context, uint32_t interruptPriority)
+{
+    uint32_t inputs = 0;
+
+    extraBits = clampExtraBits(extraBits);
+
+    (*this).extraBits = extraBits;
+    samplesPerOutput = 0x1 << (2 * extraBits);
+    (*this).result = result;
+    resultContext = context;
+    accumulator = 0;
+    accumulated = 0;
+    lastResult = 0;
+    windowCount = 0;
+    windowCycles = 0;
+    peakToPeak = 0;
+    noiseFreeBits = 0;
+    cyclesPerOutput = 0;
+
+    //Every step of the sequence converts the same input
+    for(uint32_t i = 0; i < samplesPerSequence; i++)
+    {
+        inputs |= (inputSource & 0xF) << (4 * i);
+    }
+
+    Dwt::enableCycleCounter();
+
+    converter.acquireModule(adcModule);
+    converter.initializeForInterrupt((uint32_t)sampleSequencer::SS0, (uint32_t)ssTriggerSource::timer, inputs, (uint32_t)ssControl7::END7|(uint32_t)ssControl7::IE7, sampled, this, interruptPriority);
+
+    uint32_t sequences = sequencesPerOutput(extraBits);
+    uint32_t sequenceRateHz = converter.startFixedRateSampling(trigger, block, outputRateHz * sequences);
+
+    return(sequenceRateHz / sequences);
+}
+
+/**
+ * @brief Gets the newest output.
+ * 
+ * @return 12 + extraBits bit result.
+ */
+uint32_t AdcOversampler::getLastResult(void)
+{
+    return(lastResult);
+}
+
+/**
+ * @brief Gets the resolution of the outputs.
+ * 
+ * @return 14 to 16 bits.
+ */
+uint32_t AdcOversampler::getOutputBits(void)
+{
+    return(12 + extraBits);
+}
+
+/**
+ * @brief Gets the noise free resolution of the last 64 outputs.
+ * 
+ * @return output bits minus the bits spanned by the peak to peak noise, only 
+ *         meaningful for a steady input.
+ */
+uint32_t AdcOversampler::getNoiseFreeBits(void)
+{
+    return(noiseFreeBits);
+}
+
+/**
+ * @brief Gets the peak to peak spread of the last 64 outputs.
+ * 
+ * @return spread in output LSBs.
+ */
+uint32_t AdcOversampler::getPeakToPeak(void)
+{
+    return(peakToPeak);
+}
+
+/**
+ * @brief Gets the average processor cycles spent accumulating per output 
+ *        over the last 64 outputs.
+ * 
+ * @return cycles per output, without interrupt entry and exit.
+ */
+uint32_t AdcOversampler::getCyclesPerOutput(void)
+{
+    return(cyclesPerOutput);
+}
+
+/**
+ * @brief Sequencer callback, accumulates one sequence and produces an output
+ *        every \c samplesPerOutput results.
+ * 
+ * @param samples results of the sequence.
+ * @param count number of results.
+ * @param context the AdcOversampler.
+ */
+void AdcOversampler::sampled(uint16_t* samples, uint32_t count, void* context)
+{
+    uint32_t start = Dwt::getCycleCount();
+    AdcOversampler* oversampler = (AdcOversampler*)context;
+    uint32_t sum = 0;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+
+    (*oversampler).accumulator += sum;
+    (*oversampler).accumulated += count;
+
+    if((*oversampler).accumulated < (*oversampler).samplesPerOutput)
+    {
+        (*oversampler).windowCycles += Dwt::getCycleCount() - start;
+        return;
+    }
+
+    uint32_t value = decimate((*oversampler).accumulator, (*oversampler).extraBits);
+
+    (*oversampler).accumulator = 0;
+    (*oversampler).accumulated = 0;
+    (*oversampler).lastResult = value;
+
+    if(((*oversampler).windowCount == 0) || (value < (*oversampler).windowMin))
+    {
+        (*oversampler).windowMin = value;
+    }
+
+    if(((*oversampler).windowCount == 0) || (value > (*oversampler).windowMax))
+    {
+        (*oversampler).windowMax = value;
+    }
+
+    (*oversampler).windowCount++;
+    (*oversampler).windowCycles += Dwt::getCycleCount() - start;
+
+    if((*oversampler).windowCount == reportWindow)
+    {
+        uint32_t spread = (*oversampler).windowMax - (*oversampler).windowMin;
+
+        (*oversampler).peakToPeak = spread;
+        (*oversampler).noiseFreeBits = noiseFreeResolution(12 + (*oversampler).extraBits, spread);
+        (*oversampler).cyclesPerOutput = (*oversampler).windowCycles / reportWindow;
+        (*oversampler).windowCount = 0;
+        (*oversampler).windowCycles = 0;
+    }
+
+    if((*oversampler).result != 0)
+    {
+        (*oversampler).result(value, (*oversampler).resultContext);
+    }
+}
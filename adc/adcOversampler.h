@@ -0,0 +1,167 @@
+/**
+ * @file adcOversampler.h
+ * @brief TM4C123GH6PM ADC Oversampler Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class AdcOversampler
+ * @brief TM4C123GH6PM ADC Oversampling and Decimation
+ * 
+ * @section adcOversamplerDescription ADC Oversampler Description
+ * 
+ * Raises the resolution of a slow channel from 12 bits to 14 to 16 bits by 
+ * oversampling. For n extra bits 4^n results are summed and the sum is 
+ * shifted right by n, so each output is 12 + n bits. n is 2 to 4, so every
+ * output is a whole number of 8 step sequences. This only gains 
+ * resolution when the input carries at least about 1 LSB of noise, which the
+ * ADC usually provides by itself.
+ * 
+ * Sample sequencer 0 converts the input 8 times per trigger and a general 
+ * purpose timer triggers it at the rate needed for the requested output 
+ * rate. The sequencer interrupt drains the 8 results and accumulates them, 
+ * so the processor runs once per 8 results. Only sample sequencer 0 is set 
+ * up, the sequencer priorities, hardware averaging and phase delay of the 
+ * module are left as the application set them with Adc::initializeModule. 
+ * Hardware averaging (ADCSAC) is applied to every result before it is 
+ * accumulated, it lowers noise and the interrupt rate but limits the highest
+ * output rate, since each result then takes several 1 Msps conversions.
+ * 
+ * Every 64 outputs the oversampler reports:
+ *      - The noise free resolution, the output bits minus the bits spanned
+ *        by the peak to peak output noise, for a steady input.
+ *      - The processor cycles spent accumulating per output, measured with 
+ *        the DWT cycle counter, without the interrupt entry and exit.
+ * 
+ * Example, 16-bit results at 100Hz:
+ * @code
+ * oversampler.initialize((uint32_t)adcModule::module0, (uint32_t)ssInputSrc0::AIN0, 4, 100, trigger, shortTimer1, newResult, 0, 5);
+ * @endcode
+ */
+
+#ifndef ADC_OVERSAMPLER_H
+#define ADC_OVERSAMPLER_H
+
+#include "adc.h"
+
+class AdcOversampler
+{
+    public:
+        AdcOversampler();
+        ~AdcOversampler();
+
+        uint32_t initialize(uint32_t adcModule, uint32_t inputSource, uint32_t extraBits, uint32_t outputRateHz, GeneralPurposeTimer& trigger, timerBlock block, void (*result)(uint32_t value, void* context), void* context, uint32_t interruptPriority);
+        uint32_t getLastResult(void);
+        uint32_t getOutputBits(void);
+        uint32_t getNoiseFreeBits(void);
+        uint32_t getPeakToPeak(void);
+        uint32_t getCyclesPerOutput(void);
+
+        static const uint32_t reportWindow = 64;
+        static const uint32_t minExtraBits = 2;
+        static const uint32_t maxExtraBits = 4;
+        static const uint32_t samplesPerSequence = 8;
+
+        /**
+         * @brief Limits the extra bits to the supported 2 to 4.
+         * @param extraBits requested extra bits.
+         * @return extra bits used.
+         */
+        static constexpr uint32_t clampExtraBits(uint32_t extraBits)
+        {
+            return((extraBits < minExtraBits) ? minExtraBits : ((extraBits > maxExtraBits) ? maxExtraBits : extraBits));
+        }
+
+        /**
+         * @brief Sequences summed into one output, 4^n results of 8 per 
+         *        sequence.
+         * @param extraBits 2 to 4.
+         * @return 2, 8 or 32.
+         */
+        static constexpr uint32_t sequencesPerOutput(uint32_t extraBits)
+        {
+            return((0x1u << (2 * extraBits)) / samplesPerSequence);
+        }
+
+        /**
+         * @brief Scales a sum of 4^n results to a 12 + n bit output.
+         * @param sum of \c sequencesPerOutput sequences.
+         * @param extraBits 2 to 4.
+         * @return output value.
+         */
+        static constexpr uint32_t decimate(uint32_t sum, uint32_t extraBits)
+        {
+            return(sum >> extraBits);
+        }
+
+        /**
+         * @brief Bits spanned by a peak to peak spread, the width of the 
+         *        spread as a binary number.
+         * @param spread peak to peak spread in output LSBs.
+         * @return 0 for no spread.
+         */
+        static constexpr uint32_t spreadBits(uint32_t spread)
+        {
+            return((spread == 0) ? 0 : (1 + spreadBits(spread >> 1)));
+        }
+
+        /**
+         * @brief Resolution left above the peak to peak noise.
+         * @param outputBits resolution of the outputs.
+         * @param spread peak to peak spread in output LSBs, less than 
+         *        2^outputBits.
+         * @return noise free bits.
+         */
+        static constexpr uint32_t noiseFreeResolution(uint32_t outputBits, uint32_t spread)
+        {
+            return(outputBits - spreadBits(spread));
+        }
+
+    private:
+
+        static void sampled(uint16_t* samples, uint32_t count, void* context);
+
+        Adc converter;
+        void (*result)(uint32_t value, void* context);
+        void* resultContext;
+
+        uint32_t extraBits;
+        uint32_t samplesPerOutput;
+        uint32_t accumulator;
+        uint32_t accumulated;
+        volatile uint32_t lastResult;
+
+        uint32_t windowCount;
+        uint32_t windowMin;
+        uint32_t windowMax;
+        uint32_t windowCycles;
+        volatile uint32_t peakToPeak;
+        volatile uint32_t noiseFreeBits;
+        volatile uint32_t cyclesPerOutput;
+};
+
+static_assert(AdcOversampler::sequencesPerOutput(AdcOversampler::minExtraBits) > 0, "Every output must be at least one whole sequence");
+
+#endif //ADC_OVERSAMPLER_H
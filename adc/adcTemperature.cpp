@@ -0,0 +1,173 @@
+/**
+ * @file adcTemperature.cpp
+ * @brief TM4C123GH6PM ADC Temperature Sensor Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "adcTemperature.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+AdcTemperature::AdcTemperature()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+AdcTemperature::~AdcTemperature()
+{
+
+}
+
+/**
+ * @brief Sets up a sample sequencer to read the temperature sensor on every 
+ *        step, triggered by the processor until startPeriodicSampling is 
+ *        called.
+ * 
+ * @param adcModule module to use.
+ * @param sampleSequencer spare sequencer, its depth sets the readings 
+ *        averaged per sequence.
+ * @param interruptPriority priority of the sequencer interrupt, 0 to 7.
+ */
+void AdcTemperature::initialize(uint32_t adcModule, uint32_t sampleSequencer, uint32_t interruptPriority)
+{
+    uint32_t steps = 1;
+    uint32_t sequencerControl = 0;
+
+    if(sampleSequencer == (uint32_t)sampleSequencer::SS0)
+    {
+        steps = 8;
+    }
+
+    else if(sampleSequencer != (uint32_t)sampleSequencer::SS3)
+    {
+        steps = 4;
+    }
+
+    for(uint32_t i = 0; i < steps; i++)
+    {
+        sequencerControl |= (uint32_t)ssControl0::TS0 << (4 * i);
+    }
+
+    sequencerControl |= ((uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0) << (4 * (steps - 1));
+
+    centiDegrees = 0;
+    readingCount = 0;
+
+    converter.acquireModule(adcModule);
+    converter.initializeForInterrupt(sampleSequencer, (uint32_t)ssTriggerSource::processor, 0, sequencerControl, sampled, this, interruptPriority);
+    converter.enableSampleSequencer();
+}
+
+/**
+ * @brief Starts one sequence, the reading is updated from the interrupt 
+ *        when it completes.
+ */
+void AdcTemperature::startSampling(void)
+{
+    converter.initiateSampling();
+}
+
+/**
+ * @brief Triggers the sequence from a timer instead of the processor.
+ * 
+ * @param trigger timer used to trigger the sequencer.
+ * @param block of the timer used.
+ * @param rateHz readings per second.
+ * 
+ * @return achieved rate in Hz.
+ */
+uint32_t AdcTemperature::startPeriodicSampling(GeneralPurposeTimer& trigger, timerBlock block, uint32_t rateHz)
+{
+    return(converter.startFixedRateSampling(trigger, block, rateHz));
+}
+
+/**
+ * @brief Gets the latest reading.
+ * 
+ * @return temperature in hundredths of a degree Celsius, 0 before the first 
+ *         sequence completes.
+ */
+int32_t AdcTemperature::getCentiDegrees(void)
+{
+    return(centiDegrees);
+}
+
+/**
+ * @brief Gets the number of completed sequences, a reading is fresh when 
+ *        this has changed.
+ * 
+ * @return sequences since initialize.
+ */
+uint32_t AdcTemperature::getReadingCount(void)
+{
+    return(readingCount);
+}
+
+/**
+ * @brief Converts the average of 12-bit temperature sensor counts.
+ * 
+ * @details The sum is scaled before it is divided so the averaging keeps 
+ *          its extra precision. Up to 8 readings fit 32 bits.
+ * 
+ * @param countSum sum of the ADC results of the TS steps.
+ * @param readings number of results in the sum, at least 1.
+ * 
+ * @return temperature in hundredths of a degree Celsius.
+ */
+int32_t AdcTemperature::countToCentiDegrees(uint32_t countSum, uint32_t readings)
+{
+    return(14750 - (int32_t)((24750 * countSum / readings) >> 12));
+}
+
+/**
+ * @brief Sequencer callback, averages the readings of the sequence and 
+ *        stores the temperature.
+ * 
+ * @param samples results of the sequence.
+ * @param count number of results.
+ * @param context the AdcTemperature.
+ */
+void AdcTemperature::sampled(uint16_t* samples, uint32_t count, void* context)
+{
+    AdcTemperature* temperature = (AdcTemperature*)context;
+    uint32_t sum = 0;
+
+    if(count == 0)
+    {
+        return;
+    }
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+
+    (*temperature).centiDegrees = countToCentiDegrees(sum, count);
+    (*temperature).readingCount++;
+}
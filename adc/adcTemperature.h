@@ -0,0 +1,92 @@
+/**
+ * @file adcTemperature.h
+ * @brief TM4C123GH6PM ADC Temperature Sensor Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class AdcTemperature
+ * @brief TM4C123GH6PM On-Chip Temperature Sensor
+ * 
+ * @section adcTemperatureDescription ADC Temperature Sensor Description
+ * 
+ * Samples the internal temperature sensor in the background on a spare 
+ * sample sequencer and keeps the latest reading in centidegrees Celsius. 
+ * getCentiDegrees only returns the stored value, so reading the temperature 
+ * never waits on the ADC.
+ * 
+ * Every step of the sequencer selects the sensor (TS), so SS0 takes 8 
+ * readings, SS1 and SS2 take 4 and SS3 takes 1. The readings of a sequence 
+ * are averaged in the sequencer interrupt on top of any hardware averaging 
+ * the application set for the module with Adc::initializeModule. Only the 
+ * chosen sequencer is set up, the module wide settings are left alone. The 
+ * count is converted with the data sheet formula
+ * 
+ *      TEMP = 147.5 - (75 * 3.3 * count / 4096)
+ * 
+ * in integer arithmetic, 14750 - ((24750 * count) >> 12) centidegrees.
+ * 
+ * Sequences are either started by the processor with startSampling, for 
+ * example from a SysTick handler, or triggered by a timer with 
+ * startPeriodicSampling.
+ * 
+ * Example:
+ * @code
+ * dieTemperature.initialize((uint32_t)adcModule::module1, (uint32_t)sampleSequencer::SS1, 7);
+ * dieTemperature.startPeriodicSampling(temperatureTimer, shortTimer2, 10);
+ * 
+ * if(dieTemperature.getCentiDegrees() > 8500)
+ * @endcode
+ */
+
+#ifndef ADC_TEMPERATURE_H
+#define ADC_TEMPERATURE_H
+
+#include "adc.h"
+
+class AdcTemperature
+{
+    public:
+        AdcTemperature();
+        ~AdcTemperature();
+
+        void initialize(uint32_t adcModule, uint32_t sampleSequencer, uint32_t interruptPriority);
+        void startSampling(void);
+        uint32_t startPeriodicSampling(GeneralPurposeTimer& trigger, timerBlock block, uint32_t rateHz);
+        int32_t getCentiDegrees(void);
+        uint32_t getReadingCount(void);
+
+        static int32_t countToCentiDegrees(uint32_t countSum, uint32_t readings);
+
+    private:
+
+        static void sampled(uint16_t* samples, uint32_t count, void* context);
+
+        Adc converter;
+        volatile int32_t centiDegrees;
+        volatile uint32_t readingCount;
+};
+
+#endif //ADC_TEMPERATURE_H
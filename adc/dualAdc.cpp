@@ -0,0 +1,262 @@
+/**
+ * @file dualAdc.cpp
+ * @brief TM4C123GH6PM Dual ADC Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "dualAdc.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+DualAdc::DualAdc()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+DualAdc::~DualAdc()
+{
+
+}
+
+/**
+ * @brief Sets up both ADC modules and their μDMA streams.
+ * 
+ * @param mode interleaved sampling of one input or simultaneous sampling of 
+ *        two inputs.
+ * @param sampleSequencer sequencer used on both modules.
+ * @param inputSource0 input of module 0.
+ * @param inputSource1 input of module 1, the same as \c inputSource0 when 
+ *        interleaved.
+ * @param buffer0 stream buffer of module 0.
+ * @param buffer1 stream buffer of module 1.
+ * @param merged merged block, \c bufferLength samples.
+ * @param bufferLength number of samples in each buffer, up to 2048.
+ * @param blockReady called with every merged block.
+ * @param context pointer passed to \c blockReady .
+ * @param interruptPriority priority of both sequencer interrupts, 0 to 7. 
+ *        Keep both the same so their handlers do not preempt each other.
+ */
+void DualAdc::initialize(dualAdcMode mode, uint32_t sampleSequencer, uint32_t inputSource0, uint32_t inputSource1, uint16_t* buffer0, uint16_t* buffer1, uint16_t* merged, uint32_t bufferLength, void (*blockReady)(uint16_t* samples, uint32_t count, void* context), void* context, uint32_t interruptPriority)
+{
+    uint32_t sequencerPriority = (uint32_t)ssPriority0::zeroth|(uint32_t)ssPriority1::first|(uint32_t)ssPriority2::second|(uint32_t)ssPriority3::third;
+    uint32_t sequencerControl = (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0;
+
+    (*this).merged = merged;
+    (*this).blockReady = blockReady;
+    blockReadyContext = context;
+    for(uint32_t module = 0; module < 2; module++)
+    {
+        readyBlock[module] = 0;
+        readyIndex[module] = 0;
+        deliveredCount[module] = 0;
+        overrunCount[module] = 0;
+    }
+
+    readyCount = 0;
+    missedBlockCount = 0;
+    running = false;
+
+    converter[0].initializeModule((uint32_t)adcModule::module0, sequencerPriority, (uint32_t)hardwareAvg::none, (uint32_t)phaseDelay::_0_0);
+    converter[1].initializeModule((uint32_t)adcModule::module1, sequencerPriority, (uint32_t)hardwareAvg::none, (mode == dualAdcMode::interleaved) ? (uint32_t)phaseDelay::_180 : (uint32_t)phaseDelay::_0_0);
+
+    converter[0].initializeForStreaming(sampleSequencer, (uint32_t)ssTriggerSource::timer, inputSource0, sequencerControl, buffer0, bufferLength, module0Ready, this, interruptPriority);
+    converter[1].initializeForStreaming(sampleSequencer, (uint32_t)ssTriggerSource::timer, (mode == dualAdcMode::interleaved) ? inputSource0 : inputSource1, sequencerControl, buffer1, bufferLength, module1Ready, this, interruptPriority);
+}
+
+/**
+ * @brief Starts both modules from one timer.
+ * 
+ * @param trigger timer used to trigger both modules.
+ * @param block of the timer used.
+ * @param moduleRateHz samples per second of each module, up to 1 Msps.
+ * 
+ * @return achieved rate of each module in Hz. Interleaved, the merged stream
+ *         runs at twice this rate.
+ */
+uint32_t DualAdc::startFixedRateSampling(GeneralPurposeTimer& trigger, timerBlock block, uint32_t moduleRateHz)
+{
+    uint32_t maxRateHz = converter[0].getMaxSequenceRateHz();
+
+    if(moduleRateHz > maxRateHz)
+    {
+        moduleRateHz = maxRateHz;
+    }
+
+    uint32_t achievedRateHz = trigger.initializeForAdcTrigger(block, moduleRateHz);
+
+    running = true;
+    converter[0].enableSampleSequencer();
+    converter[1].enableSampleSequencer();
+    trigger.enableTimer();
+
+    return(achievedRateHz);
+}
+
+/**
+ * @brief Stops both modules.
+ */
+void DualAdc::stop(void)
+{
+    running = false;
+    converter[0].stopStreaming();
+    converter[1].stopStreaming();
+}
+
+/**
+ * @brief Gets the number of half buffers dropped because the other module 
+ *        did not deliver the matching half in time.
+ * 
+ * @return missed block count.
+ */
+uint32_t DualAdc::getMissedBlockCount(void)
+{
+    return(missedBlockCount);
+}
+
+/**
+ * @brief Tells if both modules are sampling, false after \c stop or after a
+ *        stream overrun stopped them.
+ * 
+ * @return true while merged blocks are being delivered.
+ */
+bool DualAdc::isRunning(void)
+{
+    return(running);
+}
+
+/**
+ * @brief Interleaves two blocks into one time ordered block.
+ * 
+ * @param first samples of module 0.
+ * @param second samples of module 1, taken after (or with) the matching 
+ *        module 0 sample.
+ * @param merged 2 * \c count samples.
+ * @param count samples in each of \c first and \c second .
+ */
+void DualAdc::merge(const uint16_t* first, const uint16_t* second, uint16_t* merged, uint32_t count)
+{
+    for(uint32_t i = 0; i < count; i++)
+    {
+        merged[2 * i] = first[i];
+        merged[2 * i + 1] = second[i];
+    }
+}
+
+/**
+ * @brief Stream callback of module 0.
+ * 
+ * @param samples filled half buffer.
+ * @param count samples in the half buffer.
+ * @param context the DualAdc.
+ */
+void DualAdc::module0Ready(uint16_t* samples, uint32_t count, void* context)
+{
+    (*((DualAdc*)context)).blockDelivered(0, samples, count);
+}
+
+/**
+ * @brief Stream callback of module 1.
+ * 
+ * @param samples filled half buffer.
+ * @param count samples in the half buffer.
+ * @param context the DualAdc.
+ */
+void DualAdc::module1Ready(uint16_t* samples, uint32_t count, void* context)
+{
+    (*((DualAdc*)context)).blockDelivered(1, samples, count);
+}
+
+/**
+ * @brief Pairs the half buffers of the two modules by their number and merges
+ *        each pair.
+ * 
+ * @details A half that is still unpaired when its module delivers the next 
+ *          one is dropped, μDMA is already refilling it. Of two unpaired 
+ *          halves with different numbers the older one can no longer be 
+ *          matched and is dropped. An overrun stops both modules, since the
+ *          samples the overrun lost shift one module against the other.
+ * 
+ * @param module that delivered the half, 0 or 1.
+ * @param samples filled half buffer.
+ * @param count samples in the half buffer.
+ */
+void DualAdc::blockDelivered(uint32_t module, uint16_t* samples, uint32_t count)
+{
+    uint32_t other = 1 - module;
+
+    if(running == false)
+    {
+        return;
+    }
+
+    if(converter[module].getStreamOverrunCount() != overrunCount[module])
+    {
+        overrunCount[module] = converter[module].getStreamOverrunCount();
+        readyBlock[0] = 0;
+        readyBlock[1] = 0;
+        missedBlockCount++;
+        stop();
+        return;
+    }
+
+    if(readyBlock[module] != 0)
+    {
+        missedBlockCount++;
+    }
+
+    readyBlock[module] = samples;
+    readyIndex[module] = deliveredCount[module];
+    deliveredCount[module]++;
+    readyCount = count;
+
+    if(readyBlock[other] == 0)
+    {
+        return;
+    }
+
+    if(readyIndex[other] != readyIndex[module])
+    {
+        //Keep the newer half, its match can still arrive
+        uint32_t older = ((int32_t)(readyIndex[other] - readyIndex[module]) < 0) ? other : module;
+
+        readyBlock[older] = 0;
+        missedBlockCount++;
+        return;
+    }
+
+    merge(readyBlock[0], readyBlock[1], merged, readyCount);
+
+    readyBlock[0] = 0;
+    readyBlock[1] = 0;
+
+    if(blockReady != 0)
+    {
+        blockReady(merged, 2 * readyCount, blockReadyContext);
+    }
+}
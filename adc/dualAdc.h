@@ -0,0 +1,110 @@
+/**
+ * @file dualAdc.h
+ * @brief TM4C123GH6PM Dual ADC Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class DualAdc
+ * @brief TM4C123GH6PM Synchronized Dual ADC
+ * 
+ * @section dualAdcDescription Dual ADC Description
+ * 
+ * Runs the same sample sequencer of both ADC modules from one timer trigger, 
+ * each streaming into its own ping-pong buffer with μDMA (see 
+ * \c Adc::initializeForStreaming ). Each time both modules have filled a 
+ * half buffer, the two halves are merged into one time ordered block and 
+ * handed to the \c blockReady callback.
+ * 
+ * In \c dualAdcMode::interleaved both modules sample the same input and 
+ * module 1 samples 180º (half a conversion) after module 0, set in ADCSPC, so
+ * the merged block is one channel at twice the rate of one module, up to 
+ * 2 Msps. In \c dualAdcMode::simultaneous each module samples its own input 
+ * at the same instant and the merged block holds the pairs, module 0 first.
+ * 
+ * The halves of each module are numbered as they are delivered and only 
+ * halves with the same number, filled by the same triggers, are merged. If 
+ * the handler of one module runs late its unpaired half is dropped and 
+ * counted as missed, pairing continues with the next matching halves. A 
+ * stream overrun loses samples of one module, so its halves no longer line 
+ * up with the other module's; both modules are stopped and must be set up 
+ * again with \c initialize and \c startFixedRateSampling .
+ * 
+ * The sequence should be one step long with IE and END set. Both modules use
+ * the timer trigger, hardware averaging is off.
+ * 
+ * Example:
+ * @code
+ * uint16_t buffer0[256], buffer1[256], merged[256];
+ * 
+ * dual.initialize(dualAdcMode::interleaved, (uint32_t)sampleSequencer::SS3, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssInputSrc0::AIN0, buffer0, buffer1, merged, 256, process, 0, 2);
+ * dual.startFixedRateSampling(trigger, shortTimer1, 1000000);
+ * @endcode
+ */
+
+#ifndef DUAL_ADC_H
+#define DUAL_ADC_H
+
+#include "adc.h"
+
+/**
+ * What the two modules sample
+ */
+enum class dualAdcMode : uint32_t {interleaved, simultaneous};
+
+class DualAdc
+{
+    public:
+        DualAdc();
+        ~DualAdc();
+
+        void initialize(dualAdcMode mode, uint32_t sampleSequencer, uint32_t inputSource0, uint32_t inputSource1, uint16_t* buffer0, uint16_t* buffer1, uint16_t* merged, uint32_t bufferLength, void (*blockReady)(uint16_t* samples, uint32_t count, void* context), void* context, uint32_t interruptPriority);
+        uint32_t startFixedRateSampling(GeneralPurposeTimer& trigger, timerBlock block, uint32_t moduleRateHz);
+        void stop(void);
+        uint32_t getMissedBlockCount(void);
+        bool isRunning(void);
+
+        static void merge(const uint16_t* first, const uint16_t* second, uint16_t* merged, uint32_t count);
+
+    private:
+
+        static void module0Ready(uint16_t* samples, uint32_t count, void* context);
+        static void module1Ready(uint16_t* samples, uint32_t count, void* context);
+        void blockDelivered(uint32_t module, uint16_t* samples, uint32_t count);
+
+        Adc converter[2];
+        uint16_t* readyBlock[2];
+        uint32_t readyIndex[2];
+        uint32_t deliveredCount[2];
+        uint32_t overrunCount[2];
+        uint32_t readyCount;
+        bool running;
+        uint16_t* merged;
+        void (*blockReady)(uint16_t* samples, uint32_t count, void* context);
+        void* blockReadyContext;
+        uint32_t missedBlockCount;
+};
+
+#endif //DUAL_ADC_H
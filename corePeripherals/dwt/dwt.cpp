@@ -0,0 +1,83 @@
+/**
+ * @file dwt.cpp
+ * @brief TM4C123GH6PM DWT Driver Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+#include "dwt.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+Dwt::Dwt()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+Dwt::~Dwt()
+{
+    
+}
+
+/**
+ * @brief Starts the DWT cycle counter.
+ * 
+ * @details Enables trace (DEMCR.TRCENA) so the DWT is powered and then sets
+ *          CYCCNTENA. Calling this while the counter is already running 
+ *          leaves the count untouched.
+ */
+void Dwt::enableCycleCounter(void)
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(corePeripheralBase + DEMCR_OFFSET)), (uint32_t)setORClear::set, 24, 1, RW);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(dwtBase + DWT_CTRL_OFFSET)), (uint32_t)setORClear::set, 0, 1, RW);
+}
+
+/**
+ * @brief Reads the DWT cycle counter.
+ * 
+ * @return number of processor clock cycles counted since the counter was 
+ *         enabled, modulo 2^32.
+ */
+uint32_t Dwt::getCycleCount(void)
+{
+    return(*((volatile uint32_t*)(dwtBase + DWT_CYCCNT_OFFSET)));
+}
+
+/**
+ * @brief Gets the address of the cycle counter.
+ * 
+ * @details For timing loops that must read the counter without a function 
+ *          call, such as code running from SRAM.
+ * 
+ * @return pointer to the DWT_CYCCNT register.
+ */
+volatile uint32_t* Dwt::getCycleCountRegister(void)
+{
+    return((volatile uint32_t*)(dwtBase + DWT_CYCCNT_OFFSET));
+}
@@ -0,0 +1,76 @@
+/**
+ * @file dwt.h
+ * @brief TM4C123GH6PM DWT Driver Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class Dwt
+ * @brief TM4C123GH6PM DWT Driver
+ * 
+ * @section dwtDescription DWT Description
+ * 
+ * The Data Watchpoint and Trace unit (DWT) contains a free running 32-bit 
+ * cycle counter, CYCCNT, that increments once per processor clock cycle. It 
+ * is used by the drivers to time short code paths in processor cycles. The 
+ * counter does not run while the processor clock is stopped in sleep or 
+ * deep-sleep mode and wraps every 2^32 cycles, so only differences of two 
+ * reads a short time apart are meaningful.
+ * 
+ * For more detailed information on the DWT please see the ARMv7-M 
+ * Architecture Reference Manual, section C1.8.
+ * 
+ * @subsection dwtRegisterDescription DWT Register Description
+ * 
+ * The Dwt class contains a list of DWT registers listed as an offset relative
+ * to the hexadecimal base address of the DWT 0xE0001000. The Debug Exception
+ * and Monitor Control register is listed relative to the base address of Core
+ * Peripherals 0xE000E000.
+ */
+
+#ifndef DWT_H
+#define DWT_H
+
+#include "../../register/register.h"
+
+static const uint32_t dwtBase = 0xE0001000;
+
+class Dwt
+{
+    public:
+        Dwt();
+        ~Dwt();
+
+        static void enableCycleCounter(void);
+        static uint32_t getCycleCount(void);
+        static volatile uint32_t* getCycleCountRegister(void);
+
+    private:
+
+        static const uint32_t DEMCR_OFFSET = 0xDFC; // 0xDFC DEMCR RW 0x0000.0000 Debug Exception and Monitor Control
+        static const uint32_t DWT_CTRL_OFFSET = 0x000; // 0x000 DWT_CTRL RW 0x4000.0000 DWT Control
+        static const uint32_t DWT_CYCCNT_OFFSET = 0x004; // 0x004 DWT_CYCCNT RW 0x0000.0000 Cycle Count
+};
+#endif //DWT_H
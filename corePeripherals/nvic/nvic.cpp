@@ -144,4 +144,40 @@ void Nvic::wfi(void)
     );
     
 }
-#pragma GCC pop_options
\ No newline at end of file
+#pragma GCC pop_options
+
+/**
+ * @brief Masks every interrupt with a priority equal to or lower than 
+ *        \c priority, while higher priority interrupts keep running.
+ * @param priority 1 to 7, interrupts of this priority and numerically higher 
+ *        are masked. 0 removes the mask.
+ */
+void Nvic::setBasePriority(uint32_t priority)
+{
+    uint32_t basePriority = (priority & 0x7) << 5;
+
+    asm volatile(
+
+        "msr     BASEPRI, %0\n"
+        :
+        : "r" (basePriority)
+        : "memory"
+    );
+}
+
+/**
+ * @brief Gets the current interrupt base priority mask.
+ * @return priority set by \c setBasePriority, 0 if no mask is set.
+ */
+uint32_t Nvic::getBasePriority(void)
+{
+    uint32_t basePriority;
+
+    asm volatile(
+
+        "mrs     %0, BASEPRI\n"
+        : "=r" (basePriority)
+    );
+
+    return(basePriority >> 5);
+}
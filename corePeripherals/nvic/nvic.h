@@ -168,6 +168,8 @@ class Nvic
         static uint32_t disableInterrupts(void);
         static uint32_t enableInterrupts(void);
         static void wfi(void);
+        static void setBasePriority(uint32_t priority);
+        static uint32_t getBasePriority(void);
 
     private:
         
@@ -43,4 +43,15 @@ Sbc::Sbc()
 Sbc::~Sbc()
 {
     
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Selects which low power mode the WFI instruction enters.
+ * 
+ * @param deepSleep true to enter deep-sleep on the next WFI, false to enter
+ *        sleep.
+ */
+void Sbc::setSleepDeep(bool deepSleep)
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(corePeripheralBase + SYSCTRL_OFFSET)), (uint32_t)deepSleep, 2, 1, RW);
+}
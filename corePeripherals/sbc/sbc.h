@@ -67,6 +67,8 @@ class Sbc
         Sbc();
         ~Sbc();
 
+        static void setSleepDeep(bool deepSleep);
+
     private:
 
         static const uint32_t ACTLR_OFFSET = 0x008; // 0x008 ACTLR RW 0x0000.0000 Auxiliary Control 157
@@ -0,0 +1,109 @@
+/**
+ * @file biquad.cpp
+ * @brief TM4C123GH6PM Fixed Point Biquad Filter Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "biquad.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+BiquadQ31::BiquadQ31()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+BiquadQ31::~BiquadQ31()
+{
+
+}
+
+/**
+ * @brief Sets the sections and clears the filter history.
+ * 
+ * @param coefficients one entry per section, applied in order.
+ * @param sectionCount number of second order sections.
+ * @param state 4 * sectionCount values.
+ * @param postShift scaling of the coefficients, 0 to 30.
+ */
+void BiquadQ31::initialize(const biquadCoefficients* coefficients, uint32_t sectionCount, q31_t* state, uint32_t postShift)
+{
+    (*this).coefficients = coefficients;
+    (*this).sectionCount = sectionCount;
+    (*this).state = state;
+    (*this).postShift = postShift;
+
+    for(uint32_t i = 0; i < (4 * sectionCount); i++)
+    {
+        state[i] = 0;
+    }
+}
+
+/**
+ * @brief Filters a block through every section.
+ * 
+ * @param input Q31 samples.
+ * @param output Q31 results, may be the same buffer as \c input .
+ * @param count number of samples.
+ */
+void BiquadQ31::process(const q31_t* input, q31_t* output, uint32_t count)
+{
+    const q31_t* sectionInput = input;
+
+    for(uint32_t section = 0; section < sectionCount; section++)
+    {
+        const biquadCoefficients& c = coefficients[section];
+        q31_t* sectionState = &state[4 * section];
+        q31_t x1 = sectionState[0];
+        q31_t x2 = sectionState[1];
+        q31_t y1 = sectionState[2];
+        q31_t y2 = sectionState[3];
+
+        for(uint32_t i = 0; i < count; i++)
+        {
+            q31_t x0 = sectionInput[i];
+            int64_t accumulator = ((int64_t)c.b0 * x0) + ((int64_t)c.b1 * x1) + ((int64_t)c.b2 * x2) + ((int64_t)c.a1 * y1) + ((int64_t)c.a2 * y2);
+            q31_t y0 = Dsp::saturate32(accumulator >> (31 - postShift));
+
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            output[i] = y0;
+        }
+
+        sectionState[0] = x1;
+        sectionState[1] = x2;
+        sectionState[2] = y1;
+        sectionState[3] = y2;
+
+        //Later sections filter the output of the previous one in place
+        sectionInput = output;
+    }
+}
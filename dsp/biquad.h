@@ -0,0 +1,85 @@
+/**
+ * @file biquad.h
+ * @brief TM4C123GH6PM Fixed Point Biquad Filter Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class BiquadQ31
+ * @brief TM4C123GH6PM Q31 Biquad IIR Filter Cascade
+ * 
+ * @section biquadDescription Biquad Description
+ * 
+ * A cascade of second order sections in direct form I, each computing
+ * 
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]
+ * 
+ * Note the sign of the feedback terms: a1 and a2 are the negated 
+ * denominator coefficients of the usual transfer function, as in CMSIS-DSP.
+ * Coefficients are Q31 scaled down by 2^postShift, so coefficients up to 
+ * 2^postShift in magnitude can be used (a1 of a low pass is often close to 
+ * 2, which needs a postShift of 1). The products are summed in a 64-bit 
+ * accumulator at full precision and the sum is shifted back and saturated to
+ * Q31 per section. Every step is integer arithmetic, so results are bit
+ * identical on any target.
+ * 
+ * The state holds x[n-1], x[n-2], y[n-1], y[n-2] for each section.
+ */
+
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+#include "dsp.h"
+
+/**
+ * Coefficients of one second order section, Q31 scaled by 2^-postShift
+ */
+struct biquadCoefficients
+{
+    q31_t b0;
+    q31_t b1;
+    q31_t b2;
+    q31_t a1; //Negated denominator coefficient
+    q31_t a2; //Negated denominator coefficient
+};
+
+class BiquadQ31
+{
+    public:
+        BiquadQ31();
+        ~BiquadQ31();
+
+        void initialize(const biquadCoefficients* coefficients, uint32_t sectionCount, q31_t* state, uint32_t postShift);
+        void process(const q31_t* input, q31_t* output, uint32_t count);
+
+    private:
+
+        const biquadCoefficients* coefficients;
+        uint32_t sectionCount;
+        q31_t* state;
+        uint32_t postShift;
+};
+
+#endif //BIQUAD_H
@@ -0,0 +1,131 @@
+/**
+ * @file cic.cpp
+ * @brief TM4C123GH6PM CIC Decimator Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "cic.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+CicDecimator::CicDecimator()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+CicDecimator::~CicDecimator()
+{
+
+}
+
+/**
+ * @brief Sets the order and decimation and clears the filter history.
+ * 
+ * @param order number of integrator and comb stages, 1 to 4.
+ * @param decimation input samples per output sample, 1 or more.
+ */
+void CicDecimator::initialize(uint32_t order, uint32_t decimation)
+{
+    if(order > maxOrder)
+    {
+        order = maxOrder;
+    }
+
+    if(decimation == 0)
+    {
+        decimation = 1;
+    }
+
+    (*this).order = order;
+    (*this).decimation = decimation;
+    phase = 0;
+
+    //Gain is decimation^order, divide by it rounded up to a power of 2
+    uint32_t decimationBits = 0;
+
+    while((0x1u << decimationBits) < decimation)
+    {
+        decimationBits++;
+    }
+
+    gainShift = order * decimationBits;
+
+    for(uint32_t i = 0; i < maxOrder; i++)
+    {
+        integrator[i] = 0;
+        comb[i] = 0;
+    }
+}
+
+/**
+ * @brief Filters and decimates a block.
+ * 
+ * @param input Q15 samples.
+ * @param output Q15 results, count / decimation + 1 values at most. May be
+ *        the same buffer as \c input .
+ * @param count number of input samples.
+ * 
+ * @return number of output samples written.
+ */
+uint32_t CicDecimator::process(const q15_t* input, q15_t* output, uint32_t count)
+{
+    uint32_t outputCount = 0;
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        uint32_t value = (uint32_t)(int32_t)input[i];
+
+        for(uint32_t stage = 0; stage < order; stage++)
+        {
+            integrator[stage] += value;
+            value = integrator[stage];
+        }
+
+        phase++;
+
+        if(phase < decimation)
+        {
+            continue;
+        }
+
+        phase = 0;
+
+        for(uint32_t stage = 0; stage < order; stage++)
+        {
+            uint32_t delayed = comb[stage];
+            comb[stage] = value;
+            value -= delayed;
+        }
+
+        output[outputCount] = Dsp::saturate16(((int32_t)value) >> gainShift);
+        outputCount++;
+    }
+
+    return(outputCount);
+}
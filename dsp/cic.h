@@ -0,0 +1,73 @@
+/**
+ * @file cic.h
+ * @brief TM4C123GH6PM CIC Decimator Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class CicDecimator
+ * @brief TM4C123GH6PM CIC Decimation Filter
+ * 
+ * @section cicDescription CIC Description
+ * 
+ * Cascaded integrator-comb decimator, reduces the sample rate by \c decimation
+ * with a sinc^order low pass and no multiplications, for example to turn a 
+ * 1 Msps ADC stream into 62.5 ksps with more resolution. The integrators and
+ * combs use wrapping 32-bit arithmetic, which gives the exact result as long 
+ * as the gain, decimation^order, fits with the Q15 input in 32 bits, that is
+ * order * log2(decimation) <= 16. The output is divided by the gain rounded 
+ * up to a power of 2 and saturated to Q15.
+ * 
+ * Blocks do not need to be a multiple of \c decimation long, the phase is 
+ * kept between calls.
+ */
+
+#ifndef CIC_H
+#define CIC_H
+
+#include "dsp.h"
+
+class CicDecimator
+{
+    public:
+        CicDecimator();
+        ~CicDecimator();
+
+        void initialize(uint32_t order, uint32_t decimation);
+        uint32_t process(const q15_t* input, q15_t* output, uint32_t count);
+
+        static const uint32_t maxOrder = 4;
+
+    private:
+
+        uint32_t order;
+        uint32_t decimation;
+        uint32_t gainShift;
+        uint32_t phase;
+        uint32_t integrator[maxOrder];
+        uint32_t comb[maxOrder];
+};
+
+#endif //CIC_H
@@ -0,0 +1,105 @@
+/**
+ * @file dsp.cpp
+ * @brief TM4C123GH6PM Fixed Point DSP Primitives Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "dsp.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+Dsp::Dsp()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+Dsp::~Dsp()
+{
+
+}
+
+/**
+ * @brief Converts 12-bit ADC results to Q15, mid scale (2048) becomes 0.
+ * 
+ * @details Two samples are converted per word: shifting the packed pair left
+ *          by 4 cannot carry between the halves of a 12-bit result, and 
+ *          flipping bit 15 of each half subtracts the 0x8000 offset. 
+ *          \c samples and \c output may be the same buffer.
+ * 
+ * @param samples ADC results, 0 to 4095.
+ * @param output Q15 values.
+ * @param count number of samples.
+ */
+void Dsp::adcToQ15(const uint16_t* samples, q15_t* output, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for(; (i + 1) < count; i += 2)
+    {
+        uint32_t pair;
+        __builtin_memcpy(&pair, &samples[i], sizeof(pair));
+        pair = (pair << 4) ^ 0x80008000;
+        __builtin_memcpy(&output[i], &pair, sizeof(pair));
+    }
+
+    if(i < count)
+    {
+        output[i] = (q15_t)((uint16_t)(samples[i] << 4) ^ 0x8000);
+    }
+}
+
+/**
+ * @brief Converts Q15 values to Q31.
+ * 
+ * @param input Q15 values.
+ * @param output Q31 values.
+ * @param count number of values.
+ */
+void Dsp::q15ToQ31(const q15_t* input, q31_t* output, uint32_t count)
+{
+    for(uint32_t i = 0; i < count; i++)
+    {
+        output[i] = (q31_t)((uint32_t)(int32_t)input[i] << 16);
+    }
+}
+
+/**
+ * @brief Converts Q31 values to Q15, rounded to nearest and saturated.
+ * 
+ * @param input Q31 values.
+ * @param output Q15 values, may be the same buffer as \c input .
+ * @param count number of values.
+ */
+void Dsp::q31ToQ15(const q31_t* input, q15_t* output, uint32_t count)
+{
+    for(uint32_t i = 0; i < count; i++)
+    {
+        output[i] = saturate16((int32_t)(((int64_t)input[i] + 0x8000) >> 16));
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * @file dsp.h
+ * @brief TM4C123GH6PM Fixed Point DSP Primitives Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class Dsp
+ * @brief TM4C123GH6PM Fixed Point DSP Primitives
+ * 
+ * @section dspDescription DSP Description
+ * 
+ * Q15 and Q31 fixed point types, conversions from ADC results and the 
+ * multiply-accumulate and saturation primitives the filters in this folder
+ * are built on. A Q15 value is a 16-bit signed fraction, -1.0 to 
+ * 1.0 - 2^-15, a Q31 value is the same with 32 bits.
+ * 
+ * On the Cortex-M4 the primitives are single DSP extension instructions 
+ * (SMLALDX, SSUB16, SMULWB/T, SSAT), two packed 16-bit samples are handled
+ * per instruction. When \c __ARM_FEATURE_DSP is not defined, for example 
+ * when the filters are compiled on a PC, portable C versions with identical
+ * results are used instead, so filter output can be compared bit for bit 
+ * against a host build.
+ * 
+ * Conversions:
+ *      - \c adcToQ15 maps the 12-bit ADC range 0 to 4095 onto -1.0 to 
+ *        0.9995, two samples per word.
+ *      - \c q15ToQ31 and \c q31ToQ15 move between the two formats, the latter
+ *        with rounding and saturation.
+ */
+
+#ifndef DSP_H
+#define DSP_H
+
+#include <stdint.h>
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+class Dsp
+{
+    public:
+        Dsp();
+        ~Dsp();
+
+        static void adcToQ15(const uint16_t* samples, q15_t* output, uint32_t count);
+        static void q15ToQ31(const q15_t* input, q31_t* output, uint32_t count);
+        static void q31ToQ15(const q31_t* input, q15_t* output, uint32_t count);
+
+        /**
+         * @brief Loads two adjacent Q15 values as one word, the first one in 
+         *        the low half. The address only has to be halfword aligned.
+         * 
+         * @param address of the first value.
+         * 
+         * @return packed pair.
+         */
+        static inline uint32_t loadPair(const q15_t* address)
+        {
+            uint32_t pair;
+            __builtin_memcpy(&pair, address, sizeof(pair));
+            return(pair);
+        }
+
+        /**
+         * @brief Dual 16-bit multiply with exchange, accumulated into 64 bits
+         *        (SMLALDX). 
+         * 
+         * @return accumulator + x.low * y.high + x.high * y.low
+         */
+        static inline int64_t multiplyAccumulateCross(uint32_t x, uint32_t y, int64_t accumulator)
+        {
+#if defined(__ARM_FEATURE_DSP)
+            uint32_t low = (uint32_t)accumulator;
+            uint32_t high = (uint32_t)((uint64_t)accumulator >> 32);
+            __asm__("smlaldx %0, %1, %2, %3" : "+r"(low), "+r"(high) : "r"(x), "r"(y));
+            return((int64_t)(((uint64_t)high << 32) | low));
+#else
+            return(accumulator + ((int64_t)(int16_t)x * (int16_t)(y >> 16)) + ((int64_t)(int16_t)(x >> 16) * (int16_t)y));
+#endif
+        }
+
+        /**
+         * @brief Dual 16-bit signed subtraction (SSUB16).
+         * 
+         * @return x.low - y.low in the low half, x.high - y.high in the high 
+         *         half, each wrapped to 16 bits.
+         */
+        static inline uint32_t subtractPair(uint32_t x, uint32_t y)
+        {
+#if defined(__ARM_FEATURE_DSP)
+            uint32_t result;
+            __asm__("ssub16 %0, %1, %2" : "=r"(result) : "r"(x), "r"(y));
+            return(result);
+#else
+            return(((uint32_t)(uint16_t)((int16_t)x - (int16_t)y)) | ((uint32_t)(uint16_t)((int16_t)(x >> 16) - (int16_t)(y >> 16)) << 16));
+#endif
+        }
+
+        /**
+         * @brief 32 x 16-bit multiply keeping the upper 32 bits of the 48-bit
+         *        product (SMULWB, SMULWT).
+         * 
+         * @param word 32-bit signed factor.
+         * @param pair packed 16-bit signed factors.
+         * @param top use the high half of \c pair instead of the low half.
+         * 
+         * @return (word * half) >> 16
+         */
+        static inline int32_t multiplyWord(int32_t word, uint32_t pair, bool top)
+        {
+#if defined(__ARM_FEATURE_DSP)
+            int32_t result;
+
+            if(top == true)
+            {
+                __asm__("smulwt %0, %1, %2" : "=r"(result) : "r"(word), "r"(pair));
+            }
+
+            else
+            {
+                __asm__("smulwb %0, %1, %2" : "=r"(result) : "r"(word), "r"(pair));
+            }
+
+            return(result);
+#else
+            int16_t half = (top == true) ? (int16_t)(pair >> 16) : (int16_t)pair;
+            return((int32_t)(((int64_t)word * half) >> 16));
+#endif
+        }
+
+        /**
+         * @brief Saturates to the Q15 range (SSAT #16).
+         */
+        static inline q15_t saturate16(int32_t value)
+        {
+#if defined(__ARM_FEATURE_DSP)
+            int32_t result;
+            __asm__("ssat %0, #16, %1" : "=r"(result) : "r"(value));
+            return((q15_t)result);
+#else
+            return((q15_t)((value > 32767) ? 32767 : ((value < -32768) ? -32768 : value)));
+#endif
+        }
+
+        /**
+         * @brief Saturates a 64-bit value to the Q31 range.
+         */
+        static inline q31_t saturate32(int64_t value)
+        {
+            return((q31_t)((value > INT32_MAX) ? INT32_MAX : ((value < INT32_MIN) ? INT32_MIN : value)));
+        }
+};
+
+#endif //DSP_H
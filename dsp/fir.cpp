@@ -0,0 +1,239 @@
+/**
+ * @file fir.cpp
+ * @brief TM4C123GH6PM Fixed Point FIR Filter Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "fir.h"
+
+/**
+ * @brief empty constructor placeholder
+ */
+FirQ15::FirQ15()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+FirQ15::~FirQ15()
+{
+
+}
+
+/**
+ * @brief Sets the taps and clears the filter history.
+ * 
+ * @param coefficients b[0] to b[tapCount - 1], Q15.
+ * @param tapCount number of taps, 1 or more.
+ * @param state tapCount - 1 + maxBlockSize values.
+ * @param maxBlockSize largest block filtered in one piece.
+ */
+void FirQ15::initialize(const q15_t* coefficients, uint32_t tapCount, q15_t* state, uint32_t maxBlockSize)
+{
+    (*this).coefficients = coefficients;
+    (*this).tapCount = tapCount;
+    (*this).state = state;
+    (*this).maxBlockSize = maxBlockSize;
+
+    for(uint32_t i = 0; i < (tapCount - 1 + maxBlockSize); i++)
+    {
+        state[i] = 0;
+    }
+}
+
+/**
+ * @brief Filters a block, two taps per DSP instruction.
+ * 
+ * @param input Q15 samples.
+ * @param output Q15 results, may be the same buffer as \c input .
+ * @param count number of samples.
+ */
+void FirQ15::process(const q15_t* input, q15_t* output, uint32_t count)
+{
+    while(count > 0)
+    {
+        uint32_t blockSize = (count < maxBlockSize) ? count : maxBlockSize;
+
+        for(uint32_t i = 0; i < blockSize; i++)
+        {
+            state[tapCount - 1 + i] = input[i];
+        }
+
+        for(uint32_t i = 0; i < blockSize; i++)
+        {
+            //newest points at x[n], newest - k at x[n - k]
+            const q15_t* newest = &state[tapCount - 1 + i];
+            int64_t accumulator = 0;
+            uint32_t k = 0;
+
+            for(; (k + 1) < tapCount; k += 2)
+            {
+                //b[k] * x[n - k] + b[k + 1] * x[n - k - 1]
+                accumulator = Dsp::multiplyAccumulateCross(Dsp::loadPair(&coefficients[k]), Dsp::loadPair(newest - k - 1), accumulator);
+            }
+
+            if(k < tapCount)
+            {
+                accumulator += (int32_t)coefficients[k] * newest[-(int32_t)k];
+            }
+
+            output[i] = Dsp::saturate16((int32_t)(accumulator >> 15));
+        }
+
+        for(uint32_t i = 0; i < (tapCount - 1); i++)
+        {
+            state[i] = state[blockSize + i];
+        }
+
+        input += blockSize;
+        output += blockSize;
+        count -= blockSize;
+    }
+}
+
+/**
+ * @brief Filters a block one tap at a time in portable C, bit identical to 
+ *        \c process .
+ * 
+ * @param input Q15 samples.
+ * @param output Q15 results, may be the same buffer as \c input .
+ * @param count number of samples.
+ */
+void FirQ15::processReference(const q15_t* input, q15_t* output, uint32_t count)
+{
+    while(count > 0)
+    {
+        uint32_t blockSize = (count < maxBlockSize) ? count : maxBlockSize;
+
+        for(uint32_t i = 0; i < blockSize; i++)
+        {
+            state[tapCount - 1 + i] = input[i];
+        }
+
+        for(uint32_t i = 0; i < blockSize; i++)
+        {
+            int64_t accumulator = 0;
+
+            for(uint32_t k = 0; k < tapCount; k++)
+            {
+                accumulator += (int32_t)coefficients[k] * state[tapCount - 1 + i - k];
+            }
+
+            int64_t result = accumulator >> 15;
+            output[i] = (q15_t)((result > 32767) ? 32767 : ((result < -32768) ? -32768 : result));
+        }
+
+        for(uint32_t i = 0; i < (tapCount - 1); i++)
+        {
+            state[i] = state[blockSize + i];
+        }
+
+        input += blockSize;
+        output += blockSize;
+        count -= blockSize;
+    }
+}
+
+/**
+ * @brief empty constructor placeholder
+ */
+FirQ31::FirQ31()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+FirQ31::~FirQ31()
+{
+
+}
+
+/**
+ * @brief Sets the taps and clears the filter history.
+ * 
+ * @param coefficients b[0] to b[tapCount - 1], Q31.
+ * @param tapCount number of taps, 1 or more.
+ * @param state tapCount - 1 + maxBlockSize values.
+ * @param maxBlockSize largest block filtered in one piece.
+ */
+void FirQ31::initialize(const q31_t* coefficients, uint32_t tapCount, q31_t* state, uint32_t maxBlockSize)
+{
+    (*this).coefficients = coefficients;
+    (*this).tapCount = tapCount;
+    (*this).state = state;
+    (*this).maxBlockSize = maxBlockSize;
+
+    for(uint32_t i = 0; i < (tapCount - 1 + maxBlockSize); i++)
+    {
+        state[i] = 0;
+    }
+}
+
+/**
+ * @brief Filters a block.
+ * 
+ * @param input Q31 samples.
+ * @param output Q31 results, may be the same buffer as \c input .
+ * @param count number of samples.
+ */
+void FirQ31::process(const q31_t* input, q31_t* output, uint32_t count)
+{
+    while(count > 0)
+    {
+        uint32_t blockSize = (count < maxBlockSize) ? count : maxBlockSize;
+
+        for(uint32_t i = 0; i < blockSize; i++)
+        {
+            state[tapCount - 1 + i] = input[i];
+        }
+
+        for(uint32_t i = 0; i < blockSize; i++)
+        {
+            const q31_t* newest = &state[tapCount - 1 + i];
+            int64_t accumulator = 0;
+
+            for(uint32_t k = 0; k < tapCount; k++)
+            {
+                //High word of the Q62 product, Q30
+                accumulator += (int32_t)(((int64_t)coefficients[k] * newest[-(int32_t)k]) >> 32);
+            }
+
+            output[i] = Dsp::saturate32(accumulator * 2);
+        }
+
+        for(uint32_t i = 0; i < (tapCount - 1); i++)
+        {
+            state[i] = state[blockSize + i];
+        }
+
+        input += blockSize;
+        output += blockSize;
+        count -= blockSize;
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file fir.h
+ * @brief TM4C123GH6PM Fixed Point FIR Filter Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class FirQ15
+ * @brief TM4C123GH6PM Q15 FIR Filter
+ * 
+ * @section firDescription FIR Description
+ * 
+ * Block FIR filters, y[n] = sum of b[k] * x[n - k] for k = 0 to taps - 1. 
+ * The state buffer holds the last taps - 1 inputs followed by the block being
+ * filtered, so it must be taps - 1 + maxBlockSize long. Longer blocks are 
+ * filtered in pieces of \c maxBlockSize .
+ * 
+ * \c FirQ15 multiplies two taps per SMLALDX into a 64-bit accumulator, so it
+ * cannot overflow before the final shift and saturation to Q15. 
+ * \c processReference computes the same sum one tap at a time in portable C 
+ * and gives bit identical output, to check the fast path against.
+ * 
+ * \c FirQ31 accumulates the high 32 bits of each Q31 product (as SMMLA does) 
+ * in 64 bits, so it has one bit of headroom and rounds each product down.
+ * 
+ * Example:
+ * @code
+ * static const q15_t taps[8] = {...};
+ * q15_t state[8 - 1 + 256];
+ * FirQ15 lowPass;
+ * 
+ * lowPass.initialize(taps, 8, state, 256);
+ * 
+ * //In the ADC stream callback
+ * Dsp::adcToQ15(samples, (q15_t*)samples, count);
+ * lowPass.process((q15_t*)samples, filtered, count);
+ * @endcode
+ */
+
+#ifndef FIR_H
+#define FIR_H
+
+#include "dsp.h"
+
+class FirQ15
+{
+    public:
+        FirQ15();
+        ~FirQ15();
+
+        void initialize(const q15_t* coefficients, uint32_t tapCount, q15_t* state, uint32_t maxBlockSize);
+        void process(const q15_t* input, q15_t* output, uint32_t count);
+        void processReference(const q15_t* input, q15_t* output, uint32_t count);
+
+    private:
+
+        const q15_t* coefficients;
+        uint32_t tapCount;
+        q15_t* state;
+        uint32_t maxBlockSize;
+};
+
+class FirQ31
+{
+    public:
+        FirQ31();
+        ~FirQ31();
+
+        void initialize(const q31_t* coefficients, uint32_t tapCount, q31_t* state, uint32_t maxBlockSize);
+        void process(const q31_t* input, q31_t* output, uint32_t count);
+
+    private:
+
+        const q31_t* coefficients;
+        uint32_t tapCount;
+        q31_t* state;
+        uint32_t maxBlockSize;
+};
+
+#endif //FIR_H
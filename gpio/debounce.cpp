@@ -0,0 +1,230 @@
+/**
+ * @file debounce.cpp
+ * @brief TM4C123GH6PM Gpio Debounce Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "debounce.h"
+
+/**
+ * @brief Starts with no ports and no events, see \c initialize .
+ */
+Debounce::Debounce()
+{
+    initialize();
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+Debounce::~Debounce()
+{
+
+}
+
+/**
+ * @brief Removes all ports and clears the debounced state and events, for 
+ *        sampling from SysTick or another caller driven handler.
+ */
+void Debounce::initialize(void)
+{
+    portCount = 0;
+    activeLowMask = 0;
+
+    //Counters reset to 3, four matching samples are needed to flip a state
+    counter0 = 0xFFFFFFFF;
+    counter1 = 0xFFFFFFFF;
+    state = 0;
+    pressed = 0;
+    released = 0;
+
+    timer = 0;
+    maxSampleCycles = 0;
+
+    Dwt::enableCycleCounter();
+}
+
+/**
+ * @brief Clears the debouncer like \c initialize and starts a periodic 
+ *        timer interrupt at the sample rate.
+ * 
+ * @details The application defines the interrupt handler of the timer and 
+ *          calls \c serviceTimer from it.
+ * 
+ * @param timer timer used for the sample rate.
+ * @param block of the timer used, it is used concatenated.
+ * @param samplePeriodCycles system clock cycles between samples, around 5ms.
+ * @param interruptPriority priority of the timer interrupt, 0 to 7.
+ */
+void Debounce::initialize(GeneralPurposeTimer* timer, timerBlock block, uint32_t samplePeriodCycles, uint32_t interruptPriority)
+{
+    initialize();
+
+    (*this).timer = timer;
+    (*timer).initializeForInterupt(periodic, block, samplePeriodCycles, down, concatenated, interruptPriority);
+    (*timer).enableTimer();
+}
+
+/**
+ * @brief Adds an initialized group of input pins to the debouncer.
+ * 
+ * @param port group of input pins, it is the next slot, starting at 0.
+ * @param activeLow true if the inputs read 0 while pressed, as the launchpad 
+ *        switches with pull-ups do.
+ * 
+ * @return true if added, false if all 4 slots are in use.
+ */
+bool Debounce::addPort(GpioPort* port, bool activeLow)
+{
+    if(portCount >= maxPorts)
+    {
+        return(false);
+    }
+
+    uint32_t slotMask = (*port).getPinMask() << (portCount * bitsPerPort);
+
+    if(activeLow == true)
+    {
+        activeLowMask |= slotMask;
+    }
+
+    (*this).port[portCount] = port;
+    portCount++;
+
+    return(true);
+}
+
+/**
+ * @brief Samples every input once and advances the debounce counters.
+ * 
+ * @details Call at a fixed rate from a timer interrupt handler. Each input 
+ *          that differs from its debounced state counts down its vertical 
+ *          counter, an input that matches it resets its counter. When a 
+ *          counter expires the debounced state flips and the press or release
+ *          event is latched until it is read.
+ */
+void Debounce::sample(void)
+{
+    uint32_t start = Dwt::getCycleCount();
+    uint32_t raw = 0;
+
+    for(uint32_t i = 0; i < portCount; i++)
+    {
+        raw |= ((*port[i]).read() << (i * bitsPerPort));
+    }
+
+    uint32_t changed = (raw ^ activeLowMask) ^ state;
+
+    counter0 = ~(counter0 & changed);
+    counter1 = counter0 ^ (counter1 & changed);
+    changed &= counter0 & counter1;
+
+    state ^= changed;
+    pressed |= state & changed;
+    released |= ~state & changed;
+
+    uint32_t cycles = Dwt::getCycleCount() - start;
+
+    if(cycles > maxSampleCycles)
+    {
+        maxSampleCycles = cycles;
+    }
+}
+
+/**
+ * @brief Clears the timer interrupt and samples, call from the interrupt 
+ *        handler of the timer passed to \c initialize .
+ */
+void Debounce::serviceTimer(void)
+{
+    if(timer != 0)
+    {
+        (*timer).clearInterrupt();
+    }
+
+    sample();
+}
+
+/**
+ * @brief Gets the debounced state of all inputs.
+ * 
+ * @return 1 for every input that is pressed, bit 8k + n is pin n of slot k.
+ */
+uint32_t Debounce::getState(void)
+{
+    return(state);
+}
+
+/**
+ * @brief Gets and clears the press events.
+ * 
+ * @return 1 for every input pressed since the last call, bit 8k + n is pin n
+ *         of slot k.
+ */
+uint32_t Debounce::getPressed(void)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+
+    uint32_t events = pressed;
+    pressed = 0;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    return(events);
+}
+
+/**
+ * @brief Gets and clears the release events.
+ * 
+ * @return 1 for every input released since the last call, bit 8k + n is pin n
+ *         of slot k.
+ */
+uint32_t Debounce::getReleased(void)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+
+    uint32_t events = released;
+    released = 0;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    return(events);
+}
+
+/**
+ * @brief Gets the longest time one \c sample took.
+ * 
+ * @return processor cycles, without the interrupt entry and exit.
+ */
+uint32_t Debounce::getMaxSampleCycles(void)
+{
+    return(maxSampleCycles);
+}
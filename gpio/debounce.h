@@ -0,0 +1,116 @@
+/**
+ * @file debounce.h
+ * @brief TM4C123GH6PM Gpio Debounce Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class Debounce
+ * @brief TM4C123GH6PM Gpio Debounce
+ * 
+ * @section debounceDescription Debounce Description
+ * 
+ * Debounces up to 32 switch inputs without using gpio interrupts. Up to 4 
+ * GpioPort groups of input pins are sampled together by \c sample , which is 
+ * meant to be called at a fixed rate, around every 5ms. Given a 
+ * GeneralPurposeTimer, \c initialize sets it up to interrupt at that rate 
+ * and the timer interrupt handler, which the application defines as for any
+ * timer, only calls \c serviceTimer . Without a timer, \c sample can be 
+ * called from the SysTick handler instead.
+ * 
+ * All inputs are packed into one 32-bit word, pin n of the port added as slot
+ * k is bit 8k + n. Each bit has a 2-bit vertical counter, the two counter bits
+ * of all 32 inputs are kept in two words, so all inputs are integrated with a
+ * handful of bitwise operations per sample. An input has to read the same 
+ * changed level for 4 samples in a row before its debounced state changes and
+ * a press or release event is latched.
+ * 
+ * The cost of a sample is measured with the DWT cycle counter, 
+ * \c getMaxSampleCycles , and is the same however much the switches bounce.
+ * With edge interrupts every bounce costs an interrupt, GpioEdgeLog measures
+ * that cost per edge for comparison.
+ * 
+ * Example:
+ * @code
+ * GpioPort switches;
+ * GeneralPurposeTimer debounceTimer;
+ * Debounce debouncer;
+ * 
+ * switches.initialize(gpioBlock::portF, 0x11, input);
+ * debouncer.initialize(&debounceTimer, shortTimer0, systemClock::ticks(200), 6);
+ * debouncer.addPort(&switches, true);
+ * 
+ * extern "C" void _16_32_Bit_Timer_0A_Handler(void)
+ * {
+ *     debouncer.serviceTimer();
+ * }
+ * 
+ * //In the main loop
+ * uint32_t pressed = debouncer.getPressed();
+ * @endcode
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include "gpioPort.h"
+#include "../timer/generalPurposeTimer.h"
+
+class Debounce
+{
+    public:
+        Debounce();
+        ~Debounce();
+
+        void initialize(void);
+        void initialize(GeneralPurposeTimer* timer, timerBlock block, uint32_t samplePeriodCycles, uint32_t interruptPriority);
+        bool addPort(GpioPort* port, bool activeLow);
+        void sample(void);
+        void serviceTimer(void);
+        uint32_t getState(void);
+        uint32_t getPressed(void);
+        uint32_t getReleased(void);
+        uint32_t getMaxSampleCycles(void);
+
+    private:
+
+        static const uint32_t maxPorts = 4;
+        static const uint32_t bitsPerPort = 8;
+
+        GpioPort* port[maxPorts];
+        uint32_t portCount;
+        uint32_t activeLowMask;
+
+        uint32_t counter0;
+        uint32_t counter1;
+        uint32_t state;
+        uint32_t pressed;
+        uint32_t released;
+
+        GeneralPurposeTimer* timer;
+        uint32_t maxSampleCycles;
+};
+
+#endif //DEBOUNCE_H
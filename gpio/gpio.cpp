@@ -28,20 +28,29 @@
  */
 #include "gpio.h"
 
+void (*Gpio::interruptCallback[gpioPortCount][gpioPinsPerPort])(void* context);
+void* Gpio::interruptContext[gpioPortCount][gpioPinsPerPort];
+void (*Gpio::portHook[gpioPortCount])(uint32_t pending, void* context);
+void* Gpio::portHookContext[gpioPortCount];
+
 /**
- * @brief empty constructor placeholder
+ * @brief Marks the object as holding no clock, so the destructor and a
+ *        re-initialization release nothing until one is acquired.
  */
 Gpio::Gpio()
 {
-
+    clockAcquired = false;
 }
 
 /**
- * @brief empty deconstructor placeholder
+ * @brief Releases the gpio port clock if this gpio was initialized.
  */
 Gpio::~Gpio()
 {   
-
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::gpio, (0x1 << gpioPort), (uint32_t)clockGateMode::run);
+    }
 }
 
 /**
@@ -51,22 +60,54 @@ Gpio::~Gpio()
  */
 void Gpio::initialize(uint32_t gpio, direction dir)
 {  
-    alternateFunction = gpio%100; //get encoding for alternate function
-    gpio = gpio/100; //get rid of gpio encoding
+    uint32_t pinNumber = gpio/gpioOffset; //get rid of gpio encoding
 
-    gpioPort = (gpio/8);
-    (*this).gpio = (gpio%8);
-    (*this).dir = dir;
-    baseAddress = GPIO_Port_AHB_BASE + (gpioPort) * 0x1000;
+    configurePin(pinNumber/8, pinNumber%8, gpio%gpioOffset, dir);
+}
 
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCGCGPIO_OFFSET)), (uint32_t)setORClear::set, (uint32_t)(gpioPort), 1, RW);
-    while(Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + PRGPIO_OFFSET)), (uint32_t)(gpioPort), 1, RO) == 0)
+/**
+ * @brief Gpio initializer constructor with pad configuration.
+ * @param gpio pin to be initialized.
+ * @param dir of the gpio, to be an output or input.
+ * @param padOptions OR of \c padOption options, replaces the default pull-up of
+ *        inputs.
+ */
+void Gpio::initialize(uint32_t gpio, direction dir, padOption padOptions)
+{
+    initialize(gpio, dir);
+    setPadConfiguration(padOptions);
+}
+
+/**
+ * @brief Configures the pin from its decoded port, pin number and alternate 
+ *        function encoding. Shared by the runtime and the compile time \c Pin
+ *        initializers.
+ * @param port of the pin, 0 (A) to 5 (F).
+ * @param pin number in the port, 0 to 7.
+ * @param function alternate function encoding, 0 for GPIO, 1 for analog and
+ *        the PCTL value + 1 for a digital alternate function.
+ * @param dir of the gpio, to be an output or input.
+ */
+void Gpio::configurePin(uint32_t port, uint32_t pin, uint32_t function, direction dir)
+{
+    if(clockAcquired == true)
     {
-        //Ready?
+        PowerManager::release(clockGatedPeripheral::gpio, (0x1 << gpioPort), (uint32_t)clockGateMode::run);
     }
 
-    //Unlock NMI for use.
-    if(gpio == ((uint32_t)PF0::GPIO)/100)
+    alternateFunction = function;
+    gpioPort = port;
+    (*this).gpio = pin;
+    (*this).dir = dir;
+    baseAddress = GPIO_Port_AHB_BASE + (gpioPort) * 0x1000;
+    pinMask = 0x1 << (*this).gpio;
+    pinData = (volatile uint32_t*)(baseAddress + (pinMask << 2)); //GPIODATA address mask selecting only this pin
+
+    PowerManager::acquire(clockGatedPeripheral::gpio, (0x1 << gpioPort), (uint32_t)clockGateMode::run);
+    clockAcquired = true;
+
+    //Unlock NMI pins PD7 and PF0 for use.
+    if(((gpioPort == 3) && ((*this).gpio == 7)) || ((gpioPort == 5) && ((*this).gpio == 0)))
     {
         Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOLOCK_OFFSET)), gpioKey, 0, 32, RW);
         *(((volatile uint32_t*)(baseAddress + GPIOCR_OFFSET))) |= (0x1 << (*this).gpio);
@@ -125,15 +166,62 @@ void Gpio::initialize(uint32_t gpio, direction dir)
  */
 void Gpio::initialize(uint32_t gpio, direction dir, uint32_t interruptPriority)
 {
-    (*this).interruptPriority = interruptPriority;
-    
+    initialize(gpio, dir, interruptPriority, 0, 0);
+}
+
+/**
+ * @brief Gpio interrupt constructor with a per pin callback. Interrupts on 
+ *        both edges only.
+ * @param gpio pin to be initialized.
+ * @param dir of the gpio, to be an output or input.
+ * @param interruptPriority of the gpio, 0 being the highest priority and 7
+ *        being the lowest.
+ * @param callback called from the port interrupt handler when this pin 
+ *        interrupts, 0 for none. The interrupt is already cleared when it is
+ *        called.
+ * @param context pointer passed to the callback.
+ */
+void Gpio::initialize(uint32_t gpio, direction dir, uint32_t interruptPriority, void (*callback)(void* context), void* context)
+{
+    initialize(gpio, dir, interruptPriority, interruptSense::bothEdges, callback, context);
+}
+
+/**
+ * @brief Gpio interrupt constructor with a per pin callback and a selectable
+ *        interrupt sense.
+ * @param gpio pin to be initialized.
+ * @param dir of the gpio, to be an output or input.
+ * @param interruptPriority of the gpio, 0 being the highest priority and 7
+ *        being the lowest.
+ * @param sense edge or level that triggers the interrupt.
+ * @param callback called from the port interrupt handler when this pin 
+ *        interrupts, 0 for none. The interrupt is already cleared when it is
+ *        called.
+ * @param context pointer passed to the callback.
+ */
+void Gpio::initialize(uint32_t gpio, direction dir, uint32_t interruptPriority, interruptSense sense, void (*callback)(void* context), void* context)
+{
     initialize(gpio, dir);
+    configureInterrupt(interruptPriority, sense, callback, context);
+}
+
+/**
+ * @brief Registers the pin interrupt callback, sets the interrupt sense and
+ *        enables the port interrupt in the NVIC.
+ * @param interruptPriority of the gpio, 0 being the highest priority and 7
+ *        being the lowest.
+ * @param sense edge or level that triggers the interrupt.
+ * @param callback called from the port interrupt handler, 0 for none.
+ * @param context pointer passed to the callback.
+ */
+void Gpio::configureInterrupt(uint32_t interruptPriority, interruptSense sense, void (*callback)(void* context), void* context)
+{
+    (*this).interruptPriority = interruptPriority;
+
+    interruptContext[gpioPort][(*this).gpio] = context;
+    interruptCallback[gpioPort][(*this).gpio] = callback;
     
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOIM_OFFSET)), (uint32_t)setORClear::clear, (*this).gpio, 1, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOIS_OFFSET)), (uint32_t)setORClear::clear, (*this).gpio, 1, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOIBE_OFFSET)), (uint32_t)setORClear::set, (*this).gpio, 1, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOICR_OFFSET)), (uint32_t)setORClear::set, (*this).gpio, 1, RW);
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOIM_OFFSET)), (uint32_t)setORClear::set, (*this).gpio, 1, RW);
+    setInterruptSense(sense);
 
 
     /*
@@ -144,25 +232,226 @@ void Gpio::initialize(uint32_t gpio, direction dir, uint32_t interruptPriority)
     Nvic::activateInterrupt((interrupt)((((gpioPort) == 5) ? 30 : (gpioPort))), (*this).interruptPriority);
 }
 
+/**
+ * @brief Changes the event that triggers the pin interrupt and enables it.
+ * 
+ * @details Only the interrupt sense registers of this pin are changed, the 
+ *          rest of the pin configuration is kept. The pin interrupt is masked
+ *          while the sense is changed and any interrupt latched in the 
+ *          meantime is cleared, since changing GPIOIS, GPIOIBE or GPIOIEV can 
+ *          report a false edge. A level interrupt keeps interrupting until the
+ *          pin leaves the level, so the callback must remove the cause or 
+ *          change the sense.
+ * 
+ * @param sense edge or level that triggers the interrupt.
+ */
+void Gpio::setInterruptSense(interruptSense sense)
+{
+    setInterruptSense(gpioPort, pinMask, sense);
+}
+
+/**
+ * @brief Changes the event that triggers the interrupt of several pins of a 
+ *        port and enables their interrupts, with one write per register.
+ * 
+ * @details See the member \c setInterruptSense. The port interrupt is not 
+ *          enabled in the NVIC.
+ * 
+ * @param port of the pins, 0 (A) to 5 (F).
+ * @param pinMask pins to configure, bit n is pin n.
+ * @param sense edge or level that triggers the interrupt.
+ */
+void Gpio::setInterruptSense(uint32_t port, uint32_t pinMask, interruptSense sense)
+{
+    uint32_t portBase = GPIO_Port_AHB_BASE + (port * 0x1000);
+    bool level = (sense == interruptSense::highLevel) || (sense == interruptSense::lowLevel);
+    bool bothEdges = (sense == interruptSense::bothEdges);
+    bool highOrRising = (sense == interruptSense::risingEdge) || (sense == interruptSense::highLevel);
+
+    uint32_t primask = Nvic::disableInterrupts();
+
+    *((volatile uint32_t*)(portBase + GPIOIM_OFFSET)) &= ~pinMask;
+
+    if(level == true)
+    {
+        *((volatile uint32_t*)(portBase + GPIOIS_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIOIS_OFFSET)) &= ~pinMask;
+    }
+
+    if(bothEdges == true)
+    {
+        *((volatile uint32_t*)(portBase + GPIOIBE_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIOIBE_OFFSET)) &= ~pinMask;
+    }
+
+    if(highOrRising == true)
+    {
+        *((volatile uint32_t*)(portBase + GPIOIEV_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIOIEV_OFFSET)) &= ~pinMask;
+    }
+
+    *((volatile uint32_t*)(portBase + GPIOICR_OFFSET)) = pinMask;
+    *((volatile uint32_t*)(portBase + GPIOIM_OFFSET)) |= pinMask;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+}
+
+/**
+ * @brief Uses the pin to trigger ADC sample sequences.
+ * 
+ * @details Sets the pin in GPIOADCCTL, the ADC sample sequencer must use the
+ *          \c ssTriggerSource::gpio trigger, see \c Adc::attachGpioTrigger.
+ *          The pin interrupt is unmasked in GPIOIM as the trigger requires, 
+ *          but the port interrupt is not enabled in the NVIC. If the port 
+ *          interrupt is in use by other pins, the dispatcher clears this pin
+ *          without a callback unless one was registered.
+ * 
+ * @param sense edge or level that triggers the ADC.
+ */
+void Gpio::enableAdcTrigger(interruptSense sense)
+{
+    setInterruptSense(sense);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOADCCTL_OFFSET)), (uint32_t)setORClear::set, gpio, 1, RW);
+}
+
+/**
+ * @brief Uses the pin to trigger µDMA transfers.
+ * 
+ * @details Sets the pin in GPIODMACTL, a transfer is requested on the µDMA 
+ *          channel assigned to this port. See \c enableAdcTrigger for the 
+ *          interrupt handling.
+ * 
+ * @param sense edge or level that triggers the µDMA request.
+ */
+void Gpio::enableDmaTrigger(interruptSense sense)
+{
+    setInterruptSense(sense);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIODMACTL_OFFSET)), (uint32_t)setORClear::set, gpio, 1, RW);
+}
+
+/**
+ * @brief Stops the pin from triggering the ADC and µDMA.
+ */
+void Gpio::disableTriggers()
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOADCCTL_OFFSET)), (uint32_t)setORClear::clear, gpio, 1, RW);
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIODMACTL_OFFSET)), (uint32_t)setORClear::clear, gpio, 1, RW);
+}
+
+/**
+ * @brief Sets the drive strength, slew rate, open drain and pull resistors 
+ *        of the pin.
+ * @param padOptions OR of \c padOption options.
+ */
+void Gpio::setPadConfiguration(padOption padOptions)
+{
+    setPadConfiguration(gpioPort, pinMask, padOptions);
+}
+
+/**
+ * @brief Sets the drive strength, slew rate, open drain and pull resistors 
+ *        of several pins of a port with one write per pad register.
+ * 
+ * @details Setting a pin in one drive select or pull register clears it in 
+ *          the others in hardware, so only the selected register is written.
+ * 
+ * @param port of the pins, 0 (A) to 5 (F).
+ * @param pinMask pins to configure, bit n is pin n.
+ * @param padOptions OR of \c padOption options.
+ */
+void Gpio::setPadConfiguration(uint32_t port, uint32_t pinMask, padOption padOptions)
+{
+    uint32_t portBase = GPIO_Port_AHB_BASE + (port * 0x1000);
+    uint32_t options = (uint32_t)padOptions;
+    uint32_t drive = options & 0x3;
+
+    if(drive == (uint32_t)padOption::drive8mA)
+    {
+        *((volatile uint32_t*)(portBase + GPIODR8R_OFFSET)) |= pinMask;
+    }
+
+    else if(drive == (uint32_t)padOption::drive4mA)
+    {
+        *((volatile uint32_t*)(portBase + GPIODR4R_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIODR2R_OFFSET)) |= pinMask;
+    }
+
+    if(((options & (uint32_t)padOption::slewRateControl) != 0) && (drive == (uint32_t)padOption::drive8mA))
+    {
+        *((volatile uint32_t*)(portBase + GPIOSLR_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIOSLR_OFFSET)) &= ~pinMask;
+    }
+
+    if((options & (uint32_t)padOption::openDrain) != 0)
+    {
+        *((volatile uint32_t*)(portBase + GPIOODR_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIOODR_OFFSET)) &= ~pinMask;
+    }
+
+    if((options & (uint32_t)padOption::pullUp) != 0)
+    {
+        *((volatile uint32_t*)(portBase + GPIOPUR_OFFSET)) |= pinMask;
+    }
+
+    else if((options & (uint32_t)padOption::pullDown) != 0)
+    {
+        *((volatile uint32_t*)(portBase + GPIOPDR_OFFSET)) |= pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(portBase + GPIOPUR_OFFSET)) &= ~pinMask;
+        *((volatile uint32_t*)(portBase + GPIOPDR_OFFSET)) &= ~pinMask;
+    }
+}
+
 /**
  * @brief Clears the interrupt. Generally used in an ISR.
+ * 
+ * @details GPIOICR is write 1 to clear, so only this pin's bit is written. A 
+ *          read-modify-write would also clear every other pending pin 
+ *          interrupt of the port.
  */
 void Gpio::interruptClear()
 {
-
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIOICR_OFFSET)), (uint32_t)setORClear::set, gpio, 1, RW);
+    *((volatile uint32_t*)(baseAddress + GPIOICR_OFFSET)) = pinMask;
 }
 
 /**
  * @brief Writes to the gpio pin.
- * @param value to write to pin. Accepted values are 1 or 0.
+ * @param value to write to pin, 0 drives the pin low and any other value
+ *        drives it high.
  */
 void Gpio::write(uint32_t value)
 {
-    if((value == 0x0) || (value == 0x1))
-    {
-        Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIODATA_OFFSET)), value, gpio, 1, RW);
-    }
+    *pinData = (value != 0) ? pinMask : 0;
 }
 
 /**
@@ -171,5 +460,100 @@ void Gpio::write(uint32_t value)
  */
 uint32_t Gpio::read()
 {
-    return((Register::getRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPIODATA_OFFSET)), gpio, 1, RW)));
-}
\ No newline at end of file
+    return((*pinData) >> gpio);
+}
+
+/**
+ * @brief Inverts the output of the gpio pin.
+ * 
+ * @details The read and write both go through this pin's GPIODATA alias, so
+ *          other pins of the port are not affected.
+ */
+void Gpio::toggle()
+{
+    *pinData ^= pinMask;
+}
+
+/**
+ * @brief Sets a function called once per port interrupt with every pending 
+ *        pin, before the per pin callbacks.
+ * 
+ * @param port 0 (A) to 5 (F).
+ * @param hook called with the pending pin mask and \c context, 0 to remove.
+ * @param context pointer passed to the hook.
+ */
+void Gpio::setPortInterruptHook(uint32_t port, void (*hook)(uint32_t pending, void* context), void* context)
+{
+    if(port >= gpioPortCount)
+    {
+        return;
+    }
+
+    portHookContext[port] = context;
+    portHook[port] = hook;
+}
+
+/**
+ * @brief Demultiplexes a GPIO port interrupt to the per pin callbacks.
+ * 
+ * @details GPIOMIS is read once and all pending pins are cleared with a single
+ *          GPIOICR store before any callback runs, so an edge that arrives 
+ *          during a callback interrupts again. The port hook, if set, is 
+ *          called first with all pending pins, then the pending pins are
+ *          visited highest first using CLZ.
+ * 
+ * @param port number of the port that interrupted, 0 (A) to 5 (F).
+ */
+void Gpio::dispatchInterrupt(uint32_t port)
+{
+    uint32_t portBase = GPIO_Port_AHB_BASE + (port * 0x1000);
+    uint32_t pending = *((volatile uint32_t*)(portBase + GPIOMIS_OFFSET));
+
+    *((volatile uint32_t*)(portBase + GPIOICR_OFFSET)) = pending;
+
+    if(portHook[port] != 0)
+    {
+        portHook[port](pending, portHookContext[port]);
+    }
+
+    while(pending != 0)
+    {
+        uint32_t pin = 31 - __builtin_clz(pending);
+        pending &= ~(0x1 << pin);
+
+        if(interruptCallback[port][pin] != 0)
+        {
+            interruptCallback[port][pin](interruptContext[port][pin]);
+        }
+    }
+}
+
+extern "C" void GPIO_Port_A_Handler(void)
+{
+    Gpio::dispatchInterrupt(0);
+}
+
+extern "C" void GPIO_Port_B_Handler(void)
+{
+    Gpio::dispatchInterrupt(1);
+}
+
+extern "C" void GPIO_Port_C_Handler(void)
+{
+    Gpio::dispatchInterrupt(2);
+}
+
+extern "C" void GPIO_Port_D_Handler(void)
+{
+    Gpio::dispatchInterrupt(3);
+}
+
+extern "C" void GPIO_Port_E_Handler(void)
+{
+    Gpio::dispatchInterrupt(4);
+}
+
+extern "C" void GPIO_Port_F_Handler(void)
+{
+    Gpio::dispatchInterrupt(5);
+}
@@ -64,6 +64,35 @@
  * 
  * These drivers I have written support only the GPIO AHB, not APB.
  * 
+ * Pin reads and writes use the GPIODATA address masking, address bits [9:2]
+ * select the pins a load or store of GPIODATA affects. Each Gpio keeps a 
+ * pointer to the GPIODATA alias of its own pin, so \c write is a single store,
+ * \c read is a single load and neither can disturb other pins of the port 
+ * written at the same time from an ISR.
+ * 
+ * @subsection gpioInterruptDescription GPIO Interrupt Description
+ * 
+ * The driver defines the GPIO port A - F interrupt handlers, so applications 
+ * must not define their own \c GPIO_Port_n_Handler. Instead a callback and a
+ * context pointer are registered per pin with \c initialize. The port handler
+ * reads GPIOMIS once, clears every pending pin with a single GPIOICR store and
+ * then calls the callback of each pending pin, highest pin first, finding the
+ * pins with CLZ instead of testing all 8 bits.
+ * 
+ * A pin can also start an ADC sample sequence (GPIOADCCTL) or a µDMA transfer
+ * (GPIODMACTL) directly in hardware, see \c enableAdcTrigger and 
+ * \c enableDmaTrigger. The trigger uses the pin interrupt detection, so the 
+ * interrupt sense selects the triggering edge or level.
+ * 
+ * @subsection gpioPadDescription GPIO Pad Description
+ * 
+ * By default outputs use the 2-mA drive and inputs get the weak pull-up. The 
+ * drive strength, slew rate control, open drain and pull resistors are set 
+ * with the \c padOption options, either when the pin is initialized or later 
+ * with \c setPadConfiguration. Fast signals such as SPI clocks need the 8-mA 
+ * drive for sharp edges, slew rate control trades some edge speed for less 
+ * ringing.
+ * 
  * For more detailed information on the GPIO please see page 649 of the 
  * TM4C123GH6PM datasheet @ https://www.ti.com/lit/ds/symlink/tm4c123gh6pm.pdf
  * 
@@ -129,6 +158,7 @@
 #define GPIO_H
 
 #include "../systemControl/systemControl.h"
+#include "../systemControl/powerManager.h"
 
 static const uint32_t gpioOffset = 100;
 
@@ -198,20 +228,121 @@ enum direction
     input, output
 };
 
+/**
+ * Event that triggers a gpio interrupt
+ */
+enum class interruptSense
+{
+    bothEdges, risingEdge, fallingEdge, highLevel, lowLevel
+};
+
+/**
+ * Pad configuration options, OR one drive strength with any of the other 
+ * options, e.g. padOption::drive8mA | padOption::slewRateControl. Slew rate 
+ * control is only available with the 8-mA drive. Without \c pullUp or 
+ * \c pullDown the pin has no pull resistor.
+ */
+enum class padOption : uint32_t
+{
+    drive2mA = 0x00, drive4mA = 0x01, drive8mA = 0x02, slewRateControl = 0x04, 
+    openDrain = 0x08, pullUp = 0x10, pullDown = 0x20
+};
+
+/**
+ * @brief Combines pad configuration options.
+ */
+constexpr padOption operator|(padOption a, padOption b)
+{
+    return((padOption)((uint32_t)a | (uint32_t)b));
+}
+
+/**
+ * @brief Compile time pin descriptor.
+ * 
+ * @details Decodes a pin function of the PA0 - PF4 enums into the port, pin
+ *          number and alternate function as constants, so a pin initialized 
+ *          through \c Gpio::initialize<Pin> needs no runtime division. The 
+ *          enum class type of \c function only accepts functions that exist 
+ *          on that pin, static_assert rejects values outside the encoding.
+ * 
+ *          Example: greenLed.initialize<Pin<PF3, PF3::M1PWM7>>(output);
+ * 
+ * @tparam pinType PA0 - PF4 enum class of the pin.
+ * @tparam function of the pin, a value of \c pinType.
+ */
+template<class pinType, pinType function>
+struct Pin
+{
+    static constexpr uint32_t encoding = (uint32_t)function;
+    static constexpr uint32_t number = encoding/gpioOffset;
+    static constexpr uint32_t port = number/8;
+    static constexpr uint32_t pin = number%8;
+    static constexpr uint32_t alternateFunction = encoding%gpioOffset;
+    static constexpr uint32_t mask = 0x1 << pin;
+    static constexpr bool analog = (alternateFunction == 1);
+    static constexpr uint32_t pctl = (alternateFunction > 1) ? (alternateFunction - 1) : 0;
+
+    //Register image of the pin, applied by Gpio::initialize<Pin> with one
+    //store per register.
+    static constexpr uint32_t baseAddress = 0x40058000 + port*0x1000; //AHB aperture of the port
+    static constexpr uint32_t clockMask = 0x1 << port;
+    static constexpr bool unlock = ((port == 3) && (pin == 7)) || ((port == 5) && (pin == 0)); //NMI pins PD7 and PF0
+    static constexpr uint32_t afsel = (alternateFunction != 0) ? mask : 0;
+    static constexpr uint32_t den = analog ? 0 : mask;
+    static constexpr uint32_t amsel = analog ? mask : 0;
+    static constexpr uint32_t pctlMask = (alternateFunction > 1) ? (0xF << (pin*4)) : 0;
+    static constexpr uint32_t pctlValue = pctl << (pin*4);
+
+    static_assert(port < 6, "Pin is not on GPIO port A - F");
+    static_assert(alternateFunction <= 16, "Alternate function does not fit in GPIOPCTL");
+    static_assert(!((port == 2) && (pin < 4)), "PC0 - PC3 are the JTAG/SWD pins");
+    static_assert(!((port == 5) && (pin > 4)), "Port F only has pins PF0 - PF4");
+};
+
 class Gpio
 {
     public:
         Gpio();
         ~Gpio();
+        Gpio(const Gpio&) = delete;
+        Gpio& operator=(const Gpio&) = delete;
 
         void initialize(uint32_t gpio, direction dir);
+        void initialize(uint32_t gpio, direction dir, padOption padOptions);
         void initialize(uint32_t gpio, direction dir, uint32_t interruptPriority);
+        void initialize(uint32_t gpio, direction dir, uint32_t interruptPriority, void (*callback)(void* context), void* context);
+        void initialize(uint32_t gpio, direction dir, uint32_t interruptPriority, interruptSense sense, void (*callback)(void* context), void* context);
+        void setInterruptSense(interruptSense sense);
+        static void setInterruptSense(uint32_t port, uint32_t pinMask, interruptSense sense);
+        void enableAdcTrigger(interruptSense sense);
+        void enableDmaTrigger(interruptSense sense);
+        void disableTriggers();
+        void setPadConfiguration(padOption padOptions);
+        static void setPadConfiguration(uint32_t port, uint32_t pinMask, padOption padOptions);
+        template<class pin> void initialize(direction dir);
+        template<class pin> void initialize(direction dir, padOption padOptions);
+        template<class pin> void initialize(direction dir, uint32_t interruptPriority, interruptSense sense, void (*callback)(void* context), void* context);
         void interruptClear();
         void write(uint32_t value);
         uint32_t read();
+        void toggle();
+
+        static void dispatchInterrupt(uint32_t port);
+        static void setPortInterruptHook(uint32_t port, void (*hook)(uint32_t pending, void* context), void* context);
 
     private:
 
+        void configurePin(uint32_t port, uint32_t pin, uint32_t function, direction dir);
+        template<class pin> void configurePin(direction dir);
+        void configureInterrupt(uint32_t interruptPriority, interruptSense sense, void (*callback)(void* context), void* context);
+
+        static const uint32_t gpioPortCount = 6;
+        static const uint32_t gpioPinsPerPort = 8;
+        static void (*interruptCallback[gpioPortCount][gpioPinsPerPort])(void* context);
+        static void* interruptContext[gpioPortCount][gpioPinsPerPort];
+        static void (*portHook[gpioPortCount])(uint32_t pending, void* context);
+        static void* portHookContext[gpioPortCount];
+
         uint32_t gpio;
         direction dir;
         uint32_t interruptPriority;
@@ -219,6 +350,9 @@ class Gpio
 
         uint32_t baseAddress;
         uint32_t gpioPort;
+        bool clockAcquired;
+        uint32_t pinMask;
+        volatile uint32_t* pinData;
 
         static const uint32_t gpioKey = 0x4C4F434B;
 
@@ -270,4 +404,105 @@ class Gpio
 
 };
 
+/**
+ * @brief Compile time pin initializer.
+ * @tparam pin \c Pin descriptor of the pin and function to initialize.
+ * @param dir of the gpio, to be an output or input.
+ */
+template<class pin> void Gpio::initialize(direction dir)
+{
+    configurePin<pin>(dir);
+}
+
+/**
+ * @brief Compile time pin initializer with pad configuration.
+ * @tparam pin \c Pin descriptor of the pin and function to initialize.
+ * @param dir of the gpio, to be an output or input.
+ * @param padOptions OR of \c padOption options.
+ */
+template<class pin> void Gpio::initialize(direction dir, padOption padOptions)
+{
+    configurePin<pin>(dir);
+    setPadConfiguration(padOptions);
+}
+
+/**
+ * @brief Compile time pin initializer with a pin interrupt.
+ * @tparam pin \c Pin descriptor of the pin to initialize.
+ * @param dir of the gpio, to be an output or input.
+ * @param interruptPriority of the gpio, 0 being the highest priority and 7
+ *        being the lowest.
+ * @param sense edge or level that triggers the interrupt.
+ * @param callback called from the port interrupt handler, 0 for none.
+ * @param context pointer passed to the callback.
+ */
+template<class pin> void Gpio::initialize(direction dir, uint32_t interruptPriority, interruptSense sense, void (*callback)(void* context), void* context)
+{
+    static_assert(pin::alternateFunction == 0, "Pin interrupts need the GPIO function");
+
+    configurePin<pin>(dir);
+    configureInterrupt(interruptPriority, sense, callback, context);
+}
+
+/**
+ * @brief Applies the register image of a \c Pin descriptor.
+ * @tparam pin \c Pin descriptor of the pin and function to initialize.
+ * @param dir of the gpio, to be an output or input.
+ * 
+ * @details Straight-line version of the runtime configurePin: the base 
+ *          address, masks and field values are constants of \c pin, so each
+ *          register is read once and written with a single store and the 
+ *          function dependent branches fold at compile time. A GPIO input 
+ *          gets its pull-up as in the runtime path, a digital alternate 
+ *          function its GPIOPCTL nibble.
+ */
+template<class pin> void Gpio::configurePin(direction dir)
+{
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::gpio, (0x1 << gpioPort), (uint32_t)clockGateMode::run);
+    }
+
+    alternateFunction = (pin::alternateFunction == 0) ? 0 : (pin::alternateFunction - 1);
+    gpioPort = pin::port;
+    (*this).gpio = pin::pin;
+    (*this).dir = dir;
+    baseAddress = pin::baseAddress;
+    pinMask = pin::mask;
+    pinData = (volatile uint32_t*)(pin::baseAddress + (pin::mask << 2)); //GPIODATA address mask selecting only this pin
+
+    PowerManager::acquire(clockGatedPeripheral::gpio, pin::clockMask, (uint32_t)clockGateMode::run);
+    clockAcquired = true;
+
+    if(pin::unlock)
+    {
+        *((volatile uint32_t*)(pin::baseAddress + GPIOLOCK_OFFSET)) = gpioKey;
+        *((volatile uint32_t*)(pin::baseAddress + GPIOCR_OFFSET)) |= pin::mask;
+    }
+
+    volatile uint32_t* gpioDir = (volatile uint32_t*)(pin::baseAddress + GPIODIR_OFFSET);
+    *gpioDir = (*gpioDir & ~pin::mask) | ((uint32_t)dir << pin::pin);
+
+    if(pin::alternateFunction == 0)
+    {
+        volatile uint32_t* gpioPur = (volatile uint32_t*)(pin::baseAddress + GPIOPUR_OFFSET);
+        *gpioPur |= ((uint32_t)dir ^ 0x1) << pin::pin; //Pull-up on inputs only
+    }
+
+    if(pin::pctlMask != 0)
+    {
+        volatile uint32_t* gpioPctl = (volatile uint32_t*)(pin::baseAddress + GPIOPCTL_OFFSET);
+        *gpioPctl = (*gpioPctl & ~pin::pctlMask) | pin::pctlValue;
+    }
+
+    volatile uint32_t* gpioAfsel = (volatile uint32_t*)(pin::baseAddress + GPIOAFSEl_OFFSET);
+    *gpioAfsel = (*gpioAfsel & ~pin::mask) | pin::afsel;
+
+    volatile uint32_t* gpioDen = (volatile uint32_t*)(pin::baseAddress + GPIODEN_OFFSET);
+    *gpioDen = (*gpioDen & ~pin::mask) | pin::den;
+
+    volatile uint32_t* gpioAmsel = (volatile uint32_t*)(pin::baseAddress + GPIOAMSEL_OFFSET);
+    *gpioAmsel = (*gpioAmsel & ~pin::mask) | pin::amsel;
+}
+
 #endif //GPIO_H
\ No newline at end of file
@@ -0,0 +1,304 @@
+/**
+ * @file gpioEdgeLog.cpp
+ * @brief TM4C123GH6PM Gpio Edge Log Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "gpioEdgeLog.h"
+
+/**
+ * @brief Keeps the compiler from moving log entry accesses across the head 
+ *        and tail updates. Only head and tail are volatile, the entries are 
+ *        not. The producer is an interrupt on the same core, so no DMB is 
+ *        needed.
+ */
+static inline void compilerBarrier(void)
+{
+    __asm__ volatile("" ::: "memory");
+}
+
+/**
+ * @brief empty constructor placeholder
+ */
+GpioEdgeLog::GpioEdgeLog()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+GpioEdgeLog::~GpioEdgeLog()
+{
+
+}
+
+/**
+ * @brief Starts logging both edges of every pin of a group of input pins.
+ * 
+ * @details Installs the port interrupt hook of the group's port, so only one
+ *          edge log can be used per port. Gpio pin callbacks on the same port
+ *          keep working, they are called after the hook.
+ * 
+ * @param port initialized group of input pins.
+ * @param interruptPriority NVIC priority of the port interrupt, 0 to 7.
+ */
+void GpioEdgeLog::initialize(GpioPort* port, uint32_t interruptPriority)
+{
+    (*this).port = port;
+    pinMask = (*port).getPinMask();
+    uint32_t portNumber = (*port).getPort();
+
+    head = 0;
+    tail = 0;
+    overflowCount = 0;
+    maxRecordCycles = 0;
+    vcdTime = 0;
+    vcdHeaderWritten = false;
+
+    Dwt::enableCycleCounter();
+    lastLevel = (uint8_t)(*port).read();
+    lastTimestamp = Dwt::getCycleCount();
+
+    Gpio::setPortInterruptHook(portNumber, record, this);
+    Gpio::setInterruptSense(portNumber, pinMask, interruptSense::bothEdges);
+    Nvic::activateInterrupt((interrupt)((portNumber == 5) ? 30 : portNumber), interruptPriority);
+}
+
+/**
+ * @brief Takes the oldest record out of the log.
+ * 
+ * @param record where the oldest record is copied.
+ * 
+ * @return true if a record was copied, false if the log is empty.
+ */
+bool GpioEdgeLog::read(edgeRecord* record)
+{
+    uint32_t readIndex = tail;
+
+    if(readIndex == head)
+    {
+        return(false);
+    }
+
+    compilerBarrier(); //The entry is read after head says it is written
+    *record = log[readIndex];
+    compilerBarrier(); //and copied out before tail hands the slot back
+    tail = (readIndex + 1) & (logSize - 1);
+
+    return(true);
+}
+
+/**
+ * @brief Gets the number of edges dropped because the log was full.
+ * 
+ * @return dropped edge count since initialize.
+ */
+uint32_t GpioEdgeLog::getOverflowCount(void)
+{
+    return(overflowCount);
+}
+
+/**
+ * @brief Gets the most cycles the interrupt hook has taken to record an edge.
+ * 
+ * @return cycles from the timestamp to the end of the record, without the 
+ *         interrupt entry and dispatch.
+ */
+uint32_t GpioEdgeLog::getMaxRecordCycles(void)
+{
+    return(maxRecordCycles);
+}
+
+/**
+ * @brief Drains the log as a Value Change Dump, to view with GTKWave or a 
+ *        similar viewer.
+ * 
+ * @details The header and the initial levels are written on the first call,
+ *          later calls continue the dump with the new records. Each pin of
+ *          the group is a wire named after it, for example PB0. Times are in 
+ *          ns from initialize, converted with the system clock at the time of
+ *          the call. Timestamps are taken modulo 2^32 cycles, so drain the log
+ *          at least once every 53 seconds at 80MHz.
+ * 
+ * @param putChar called with every character of the dump and \c context .
+ * @param context pointer passed to \c putChar .
+ */
+void GpioEdgeLog::writeVcd(void (*putChar)(char character, void* context), void* context)
+{
+    char portLetter = (char)('A' + (*port).getPort());
+
+    if(vcdHeaderWritten == false)
+    {
+        writeString("$timescale 1 ns $end\n$scope module gpio $end\n", putChar, context);
+
+        for(uint32_t pin = 0; pin < 8; pin++)
+        {
+            if(((pinMask >> pin) & 1) != 0)
+            {
+                writeString("$var wire 1 ", putChar, context);
+                putChar((char)('!' + pin), context);
+                writeString(" P", putChar, context);
+                putChar(portLetter, context);
+                putChar((char)('0' + pin), context);
+                writeString(" $end\n", putChar, context);
+            }
+        }
+
+        writeString("$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n", putChar, context);
+
+        for(uint32_t pin = 0; pin < 8; pin++)
+        {
+            if(((pinMask >> pin) & 1) != 0)
+            {
+                putChar((char)('0' + ((lastLevel >> pin) & 1)), context);
+                putChar((char)('!' + pin), context);
+                putChar('\n', context);
+            }
+        }
+
+        writeString("$end\n", putChar, context);
+        vcdHeaderWritten = true;
+    }
+
+    uint64_t clockHz = SystemControl::getSystemClockHz();
+
+    if(clockHz == 0)
+    {
+        clockHz = 1;
+    }
+
+    edgeRecord edge;
+
+    while(read(&edge) == true)
+    {
+        vcdTime += (uint32_t)(edge.timestamp - lastTimestamp);
+        lastTimestamp = edge.timestamp;
+
+        putChar('#', context);
+        //Whole seconds and the remainder are scaled apart so the product stays
+        //within 64 bits, clocks that are not a whole MHz are not rounded.
+        writeNumber(((vcdTime / clockHz) * 1000000000) + (((vcdTime % clockHz) * 1000000000) / clockHz), putChar, context);
+        putChar('\n', context);
+
+        uint32_t pins = (edge.changed | (edge.level ^ lastLevel)) & pinMask;
+
+        for(uint32_t pin = 0; pin < 8; pin++)
+        {
+            if(((pins >> pin) & 1) != 0)
+            {
+                putChar((char)('0' + ((edge.level >> pin) & 1)), context);
+                putChar((char)('!' + pin), context);
+                putChar('\n', context);
+            }
+        }
+
+        lastLevel = edge.level;
+    }
+}
+
+/**
+ * @brief Port interrupt hook, pushes one record into the log.
+ * 
+ * @param pending pins of the port that interrupted.
+ * @param context the GpioEdgeLog.
+ */
+void GpioEdgeLog::record(uint32_t pending, void* context)
+{
+    uint32_t start = Dwt::getCycleCount();
+    GpioEdgeLog* edgeLog = (GpioEdgeLog*)context;
+    uint32_t changed = pending & (*edgeLog).pinMask;
+
+    if(changed == 0)
+    {
+        return;
+    }
+
+    uint32_t writeIndex = (*edgeLog).head;
+    uint32_t nextIndex = (writeIndex + 1) & (logSize - 1);
+
+    if(nextIndex == (*edgeLog).tail)
+    {
+        (*edgeLog).overflowCount++;
+    }
+
+    else
+    {
+        (*edgeLog).log[writeIndex].timestamp = start;
+        (*edgeLog).log[writeIndex].changed = (uint8_t)changed;
+        (*edgeLog).log[writeIndex].level = (uint8_t)(*(*edgeLog).port).read();
+        compilerBarrier(); //The entry is complete before head publishes it
+        (*edgeLog).head = nextIndex;
+    }
+
+    uint32_t cycles = Dwt::getCycleCount() - start;
+
+    if(cycles > (*edgeLog).maxRecordCycles)
+    {
+        (*edgeLog).maxRecordCycles = cycles;
+    }
+}
+
+/**
+ * @brief Writes an unsigned number in decimal.
+ * 
+ * @param number to write.
+ * @param putChar called with every digit and \c context .
+ * @param context pointer passed to \c putChar .
+ */
+void GpioEdgeLog::writeNumber(uint64_t number, void (*putChar)(char character, void* context), void* context)
+{
+    char digits[20];
+    uint32_t count = 0;
+
+    do
+    {
+        digits[count] = (char)('0' + (number % 10));
+        number /= 10;
+        count++;
+    } while(number != 0);
+
+    while(count > 0)
+    {
+        count--;
+        putChar(digits[count], context);
+    }
+}
+
+/**
+ * @brief Writes a null terminated string.
+ * 
+ * @param string to write.
+ * @param putChar called with every character and \c context .
+ * @param context pointer passed to \c putChar .
+ */
+void GpioEdgeLog::writeString(const char* string, void (*putChar)(char character, void* context), void* context)
+{
+    while(*string != '\0')
+    {
+        putChar(*string, context);
+        string++;
+    }
+}
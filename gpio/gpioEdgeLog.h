@@ -0,0 +1,113 @@
+/**
+ * @file gpioEdgeLog.h
+ * @brief TM4C123GH6PM Gpio Edge Log Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class GpioEdgeLog
+ * @brief TM4C123GH6PM Gpio Edge Log
+ * 
+ * @section gpioEdgeLogDescription Gpio Edge Log Description
+ * 
+ * Logs every edge on a GpioPort group of input pins with a DWT cycle counter
+ * timestamp, for looking at protocol timing or switch bounce without a logic
+ * analyzer. The port interrupt hook takes the timestamp and the pin levels 
+ * and pushes an \c edgeRecord into a single producer, single consumer ring 
+ * buffer, the main loop drains it with \c read or \c writeVcd .
+ * 
+ * The ring is lock free, the interrupt handler only writes the head and the 
+ * consumer only writes the tail. When the ring is full new edges are dropped
+ * and counted, \c getOverflowCount gives the number lost. The hook times 
+ * itself, \c getMaxRecordCycles gives the most cycles one record has taken,
+ * not counting the interrupt entry and dispatch.
+ * 
+ * Pulses shorter than the interrupt latency are recorded as a changed pin 
+ * with the level unchanged.
+ * 
+ * Example:
+ * @code
+ * GpioPort probes;
+ * GpioEdgeLog edgeLog;
+ * 
+ * probes.initialize(gpioBlock::portB, 0x03, input);
+ * edgeLog.initialize(&probes, 1);
+ * 
+ * //In the main loop, putChar sends a character out of a UART
+ * edgeLog.writeVcd(putChar, 0);
+ * @endcode
+ */
+
+#ifndef GPIO_EDGE_LOG_H
+#define GPIO_EDGE_LOG_H
+
+#include "gpioPort.h"
+
+/**
+ * One logged port interrupt
+ */
+struct edgeRecord
+{
+    uint32_t timestamp; //DWT cycle count when the interrupt was handled
+    uint8_t changed; //Pins that interrupted, bit n is pin n of the port
+    uint8_t level; //Levels of the group pins after the edge, bit n is pin n of the port
+};
+
+class GpioEdgeLog
+{
+    public:
+        GpioEdgeLog();
+        ~GpioEdgeLog();
+
+        void initialize(GpioPort* port, uint32_t interruptPriority);
+        bool read(edgeRecord* record);
+        uint32_t getOverflowCount(void);
+        uint32_t getMaxRecordCycles(void);
+        void writeVcd(void (*putChar)(char character, void* context), void* context);
+
+        static const uint32_t logSize = 128;
+
+    private:
+
+        static void record(uint32_t pending, void* context);
+        static void writeNumber(uint64_t number, void (*putChar)(char character, void* context), void* context);
+        static void writeString(const char* string, void (*putChar)(char character, void* context), void* context);
+
+        GpioPort* port;
+        uint32_t pinMask;
+
+        edgeRecord log[logSize];
+        volatile uint32_t head;
+        volatile uint32_t tail;
+        volatile uint32_t overflowCount;
+        volatile uint32_t maxRecordCycles;
+
+        uint32_t lastTimestamp;
+        uint8_t lastLevel;
+        uint64_t vcdTime;
+        bool vcdHeaderWritten;
+};
+
+#endif //GPIO_EDGE_LOG_H
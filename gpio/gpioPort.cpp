@@ -0,0 +1,183 @@
+/**
+ * @file gpioPort.cpp
+ * @brief TM4C123GH6PM Gpio Port Driver Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "gpioPort.h"
+#include "../systemControl/powerManager.h"
+
+/**
+ * @brief Marks the object as holding no clock, so the destructor and a
+ *        re-initialization release nothing until one is acquired.
+ */
+GpioPort::GpioPort()
+{
+    clockAcquired = false;
+}
+
+/**
+ * @brief Releases the gpio port clock if the port was initialized.
+ */
+GpioPort::~GpioPort()
+{
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::gpio, (0x1 << port), (uint32_t)clockGateMode::run);
+    }
+}
+
+/**
+ * @brief Initializes a group of pins on one port as digital GPIOs.
+ * 
+ * @details Each configuration register is written once for the whole group.
+ *          Inputs get the weak pull-up enabled, like the Gpio class does. The
+ *          NMI pins PD7 and PF0 are unlocked when they are part of the group.
+ * 
+ * @param port gpio port the pins are on.
+ * @param pinMask pins of the port to use, bit n is pin n.
+ * @param dir of all pins in the group, to be outputs or inputs.
+ */
+void GpioPort::initialize(gpioBlock port, uint32_t pinMask, direction dir)
+{
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::gpio, (0x1 << (*this).port), (uint32_t)clockGateMode::run);
+    }
+
+    (*this).port = (uint32_t)port;
+    (*this).pinMask = pinMask & 0xFF;
+
+    if(port == gpioBlock::portC)
+    {
+        (*this).pinMask &= ~jtagPins;
+    }
+
+    baseAddress = GPIO_Port_AHB_BASE + ((*this).port * 0x1000);
+    portData = (volatile uint32_t*)(baseAddress + ((*this).pinMask << 2)); //GPIODATA address mask selecting only the group
+
+    PowerManager::acquire(clockGatedPeripheral::gpio, (0x1 << (*this).port), (uint32_t)clockGateMode::run);
+    clockAcquired = true;
+
+    //Unlock NMI pins PD7 and PF0 for use.
+    if(((port == gpioBlock::portD) && (((*this).pinMask & 0x80) != 0)) || ((port == gpioBlock::portF) && (((*this).pinMask & 0x01) != 0)))
+    {
+        *((volatile uint32_t*)(baseAddress + GPIOLOCK_OFFSET)) = gpioKey;
+        *((volatile uint32_t*)(baseAddress + GPIOCR_OFFSET)) |= (*this).pinMask;
+    }
+
+    if(dir == output)
+    {
+        *((volatile uint32_t*)(baseAddress + GPIODIR_OFFSET)) |= (*this).pinMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(baseAddress + GPIODIR_OFFSET)) &= ~((*this).pinMask);
+        *((volatile uint32_t*)(baseAddress + GPIOPUR_OFFSET)) |= (*this).pinMask;
+    }
+
+    *((volatile uint32_t*)(baseAddress + GPIOAFSEl_OFFSET)) &= ~((*this).pinMask);
+    *((volatile uint32_t*)(baseAddress + GPIOAMSEL_OFFSET)) &= ~((*this).pinMask);
+    *((volatile uint32_t*)(baseAddress + GPIODEN_OFFSET)) |= (*this).pinMask;
+}
+
+/**
+ * @brief Initializes a group of pins on one port as digital GPIOs with a pad
+ *        configuration.
+ * 
+ * @param port gpio port the pins are on.
+ * @param pinMask pins of the port to use, bit n is pin n.
+ * @param dir of all pins in the group, to be outputs or inputs.
+ * @param padOptions OR of \c padOption options, replaces the default pull-up of
+ *        inputs.
+ */
+void GpioPort::initialize(gpioBlock port, uint32_t pinMask, direction dir, padOption padOptions)
+{
+    initialize(port, pinMask, dir);
+    setPadConfiguration(padOptions);
+}
+
+/**
+ * @brief Sets the drive strength, slew rate, open drain and pull resistors 
+ *        of every pin of the group.
+ * 
+ * @param padOptions OR of \c padOption options.
+ */
+void GpioPort::setPadConfiguration(padOption padOptions)
+{
+    Gpio::setPadConfiguration(port, pinMask, padOptions);
+}
+
+/**
+ * @brief Writes all pins of the group with a single store.
+ * 
+ * @param value pin values in port bit positions, bits outside the pin mask 
+ *        are ignored.
+ */
+void GpioPort::write(uint32_t value)
+{
+    *portData = value;
+}
+
+/**
+ * @brief Reads all pins of the group with a single load.
+ * 
+ * @return pin values in port bit positions, bits outside the pin mask are 0.
+ */
+uint32_t GpioPort::read()
+{
+    return(*portData);
+}
+
+/**
+ * @brief Inverts the outputs of some pins of the group.
+ * 
+ * @param pins to invert in port bit positions.
+ */
+void GpioPort::toggle(uint32_t pins)
+{
+    *portData ^= pins;
+}
+
+/**
+ * @brief Gets the pins owned by the group.
+ * 
+ * @return pin mask in port bit positions.
+ */
+uint32_t GpioPort::getPinMask()
+{
+    return(pinMask);
+}
+
+/**
+ * @brief Gets the port of the group.
+ * 
+ * @return port number, 0 (A) to 5 (F).
+ */
+uint32_t GpioPort::getPort()
+{
+    return(port);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file gpioPort.h
+ * @brief TM4C123GH6PM Gpio Port Driver Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class GpioPort
+ * @brief TM4C123GH6PM Gpio Port Driver
+ * 
+ * @section gpioPortDescription Gpio Port Description
+ * 
+ * A GpioPort owns a group of pins on one GPIO AHB port, for example the 8 data
+ * lines of a parallel LCD bus or the rows of a keypad matrix. All pins are 
+ * configured with one write per configuration register and are then read or 
+ * written together with a single access to GPIODATA through the address mask
+ * of the group (see the Gpio class). Pins of the port outside the group are 
+ * never affected, so a GpioPort and Gpio objects can share a port.
+ * 
+ * Pin values are given in port bit positions, bit n is pin n of the port. Bits
+ * outside the pin mask are ignored on writes and read back as 0.
+ * 
+ * The JTAG/SWD pins PC0 - PC3 are always removed from the pin mask.
+ */
+
+#ifndef GPIO_PORT_H
+#define GPIO_PORT_H
+
+#include "gpio.h"
+
+/**
+ * GPIO AHB port
+ */
+enum class gpioBlock
+{
+    portA, portB, portC, portD, portE, portF
+};
+
+class GpioPort
+{
+    public:
+        GpioPort();
+        ~GpioPort();
+        GpioPort(const GpioPort&) = delete;
+        GpioPort& operator=(const GpioPort&) = delete;
+
+        void initialize(gpioBlock port, uint32_t pinMask, direction dir);
+        void initialize(gpioBlock port, uint32_t pinMask, direction dir, padOption padOptions);
+        void setPadConfiguration(padOption padOptions);
+        void write(uint32_t value);
+        uint32_t read();
+        void toggle(uint32_t pins);
+        uint32_t getPinMask();
+        uint32_t getPort();
+
+    private:
+
+        uint32_t port;
+        uint32_t pinMask;
+        uint32_t baseAddress;
+        volatile uint32_t* portData;
+        bool clockAcquired;
+
+        static const uint32_t gpioKey = 0x4C4F434B;
+        static const uint32_t jtagPins = 0x0F; //PC0 - PC3
+
+        static const uint32_t GPIO_Port_AHB_BASE = 0x40058000;
+
+        static const uint32_t GPIODATA_OFFSET = 0x3FC; // 0x000 GPIODATA RW 0x0000.0000 GPIO Data 662
+        static const uint32_t GPIODIR_OFFSET = 0x400; // 0x400 GPIODIR RW 0x0000.0000 GPIO Direction 663
+        static const uint32_t GPIOAFSEl_OFFSET = 0x420; // 0x420 GPIOAFSEL RW - GPIO Alternate Function Select 671
+        static const uint32_t GPIOPUR_OFFSET = 0x510; // 0x510 GPIOPUR RW - GPIO Pull-Up Select 677
+        static const uint32_t GPIODEN_OFFSET = 0x51C; // 0x51C GPIODEN RW - GPIO Digital Enable 682
+        static const uint32_t GPIOLOCK_OFFSET = 0x520; // 0x520 GPIOLOCK RW 0x0000.0001 GPIO Lock 684
+        static const uint32_t GPIOCR_OFFSET = 0x524; // 0x524 GPIOCR - - GPIO Commit 685
+        static const uint32_t GPIOAMSEL_OFFSET = 0x528; // 0x528 GPIOAMSEL RW 0x0000.0000 GPIO Analog Mode Select 687
+};
+
+#endif //GPIO_PORT_H
@@ -0,0 +1,186 @@
+/**
+ * @file gpioWaveform.cpp
+ * @brief TM4C123GH6PM Gpio Waveform Generator Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "gpioWaveform.h"
+
+/**
+ * The playback loop is copied to SRAM with .data by the startup code, it is 
+ * called with a long call since SRAM is out of branch range of flash.
+ */
+#if defined(__arm__)
+#define RAM_FUNCTION __attribute__((section(".data.ramfunc"), long_call, noinline))
+#else
+#define RAM_FUNCTION __attribute__((noinline))
+#endif
+
+static void playSteps(uint32_t portBase, waveformStep* steps, uint32_t stepCount, uint32_t startDelay, volatile uint32_t* cycleCounter, waveformReport* report) RAM_FUNCTION;
+
+/**
+ * @brief Plays the steps, runs from SRAM with interrupts masked.
+ * 
+ * @param portBase GPIO AHB port base address.
+ * @param steps table to play.
+ * @param stepCount number of steps, at least 1.
+ * @param startDelay cycles from entry to the first step deadline.
+ * @param cycleCounter DWT_CYCCNT register.
+ * @param report filled with the achieved timing.
+ */
+static void playSteps(uint32_t portBase, waveformStep* steps, uint32_t stepCount, uint32_t startDelay, volatile uint32_t* cycleCounter, waveformReport* report)
+{
+    uint32_t deadline = *cycleCounter + startDelay;
+    uint32_t firstStore = 0;
+    uint32_t store = 0;
+    uint32_t maxLate = 0;
+    uint32_t lateSteps = 0;
+
+    for(uint32_t i = 0; i < stepCount; i++)
+    {
+        volatile uint32_t* data = (volatile uint32_t*)(portBase + (steps[i].mask << 2)); //GPIODATA address mask of the step
+        uint32_t value = steps[i].value;
+
+        while((int32_t)(*cycleCounter - deadline) < 0)
+        {
+
+        }
+
+        *data = value;
+        store = *cycleCounter;
+
+        if(i == 0)
+        {
+            firstStore = store;
+        }
+
+        uint32_t late = store - deadline;
+
+        if(late > maxLate)
+        {
+            maxLate = late;
+        }
+
+        if(late > GpioWaveform::lateTolerance)
+        {
+            lateSteps++;
+        }
+
+        deadline += steps[i].delayCycles;
+    }
+
+    (*report).achievedCycles = store - firstStore;
+    (*report).maxLateCycles = maxLate;
+    (*report).lateSteps = lateSteps;
+}
+
+/**
+ * @brief empty constructor placeholder
+ */
+GpioWaveform::GpioWaveform()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+GpioWaveform::~GpioWaveform()
+{
+
+}
+
+/**
+ * @brief Selects the port the waveforms are played on.
+ * 
+ * @param port gpio port of the waveform pins.
+ * @param maskPriority interrupts of this priority and lower (numerically 
+ *        higher) are masked while a waveform plays, 1 to 7. 0 masks all 
+ *        interrupts.
+ */
+void GpioWaveform::initialize(gpioBlock port, uint32_t maskPriority)
+{
+    baseAddress = GPIO_Port_AHB_BASE + ((uint32_t)port * 0x1000);
+    (*this).maskPriority = maskPriority;
+
+    Dwt::enableCycleCounter();
+}
+
+/**
+ * @brief Plays a waveform table, returns after the last step is written.
+ * 
+ * @param steps table to play.
+ * @param stepCount number of steps in the table.
+ */
+void GpioWaveform::play(waveformStep* steps, uint32_t stepCount)
+{
+    report.requestedCycles = 0;
+    report.achievedCycles = 0;
+    report.maxLateCycles = 0;
+    report.lateSteps = 0;
+
+    if(stepCount == 0)
+    {
+        return;
+    }
+
+    for(uint32_t i = 0; i < (stepCount - 1); i++)
+    {
+        report.requestedCycles += steps[i].delayCycles;
+    }
+
+    uint32_t primask = 1;
+    uint32_t basePriority = Nvic::getBasePriority();
+
+    if(maskPriority == 0)
+    {
+        primask = Nvic::disableInterrupts();
+    }
+
+    else
+    {
+        Nvic::setBasePriority(maskPriority);
+    }
+
+    playSteps(baseAddress, steps, stepCount, startDelayCycles, Dwt::getCycleCountRegister(), &report);
+
+    Nvic::setBasePriority(basePriority);
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+}
+
+/**
+ * @brief Gets the achieved timing of the last playback.
+ * 
+ * @return requested and achieved cycles between the first and the last step
+ *         and how late the steps were written.
+ */
+waveformReport GpioWaveform::getReport(void)
+{
+    return(report);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file gpioWaveform.h
+ * @brief TM4C123GH6PM Gpio Waveform Generator Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class GpioWaveform
+ * @brief TM4C123GH6PM Gpio Waveform Generator
+ * 
+ * @section gpioWaveformDescription Gpio Waveform Description
+ * 
+ * Plays a table of \c waveformStep entries on one GPIO port, for custom serial
+ * protocols or test stimuli that need tighter timing than toggling pins from
+ * an interrupt handler. Each step writes \c value to the pins in \c mask with 
+ * a single masked GPIODATA store and the next step is written 
+ * \c delayCycles system clock cycles later.
+ * 
+ * The playback loop runs from SRAM, so flash wait states do not add jitter, 
+ * and times every store against an absolute DWT cycle counter deadline, so 
+ * a late step does not delay the steps after it. Interrupts of the mask 
+ * priority and lower are masked with BASEPRI while the table plays. For the 
+ * best timing keep the step table in SRAM as well (not \c const ).
+ * 
+ * The pins must be initialized as outputs first, for example with a GpioPort.
+ * Steps closer together than the loop overhead, around 10 cycles, play late;
+ * \c getReport gives the achieved timing of the last playback. Tables can be
+ * checked on a PC first with GpioWaveformSimulator in the test folder, which 
+ * models this loop and records the pin timeline.
+ */
+
+#ifndef GPIO_WAVEFORM_H
+#define GPIO_WAVEFORM_H
+
+#include "gpioPort.h"
+
+/**
+ * One entry of a waveform table.
+ */
+struct waveformStep
+{
+    uint32_t mask; //Pins to write, bit n is pin n of the port
+    uint32_t value; //Pin values, bit n is pin n of the port
+    uint32_t delayCycles; //System clock cycles until the next step
+};
+
+/**
+ * Achieved timing of a waveform playback.
+ */
+struct waveformReport
+{
+    uint32_t requestedCycles; //Sum of the step delays between the first and the last step
+    uint32_t achievedCycles; //Cycles between the first and the last step store
+    uint32_t maxLateCycles; //Largest delay of a store past its deadline
+    uint32_t lateSteps; //Number of steps stored more than lateTolerance cycles past their deadline
+};
+
+class GpioWaveform
+{
+    public:
+        GpioWaveform();
+        ~GpioWaveform();
+
+        void initialize(gpioBlock port, uint32_t maskPriority);
+        void play(waveformStep* steps, uint32_t stepCount);
+        waveformReport getReport(void);
+
+        static const uint32_t lateTolerance = 4;
+
+    private:
+
+        uint32_t baseAddress;
+        uint32_t maskPriority;
+        waveformReport report;
+
+        static const uint32_t startDelayCycles = 32;
+
+        static const uint32_t GPIO_Port_AHB_BASE = 0x40058000;
+};
+
+#endif //GPIO_WAVEFORM_H
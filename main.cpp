@@ -29,10 +29,9 @@ along with this program.  If not, see <https://www.gnu.org/licenses/.
 
 #include "main.h"
 
-int readme = -1;
-float voltageValue = -1;
+volatile uint32_t milliVolts;
 
-uint32_t adcResolution;
+AdcCalibration ain0Calibration;
 
 Gpio greenLed;
 Gpio blueLed;
@@ -64,33 +63,34 @@ void __gnu_cxx::__verbose_terminate_handler()
     while(1);
 }
 
-extern "C" void GPIO_Port_F_Handler(void)
+/**
+ * Switch and the LED it lights while pressed.
+ */
+struct switchLed
 {
-    
-    if(swtich1.read() == 1)
-    {
-        redLed.write((uint32_t)setORClear::clear);
-        swtich1.interruptClear();
-    }
+    Gpio* button;
+    Gpio* led;
+};
 
-    if(swtich1.read() == 0)
-    {
-        redLed.write((uint32_t)setORClear::set);
-        swtich1.interruptClear();
-    }
+switchLed switch1Led = {&swtich1, &redLed};
+switchLed switch2Led = {&swtich2, &blueLed};
+
+/**
+ * Switch interrupt callback, the switches pull low when pressed.
+ */
+void switchChanged(void* context)
+{
+    switchLed* pair = (switchLed*)context;
 
-    if(swtich2.read() == 1)
+    if((*pair).button->read() == 1)
     {
-        blueLed.write((uint32_t)setORClear::clear);
-        swtich2.interruptClear();
+        (*pair).led->write((uint32_t)setORClear::clear);
     }
 
-    if(swtich2.read() == 0)
+    else
     {
-        blueLed.write((uint32_t)setORClear::set);
-        swtich2.interruptClear();
+        (*pair).led->write((uint32_t)setORClear::set);
     }
-
 }
 
 // extern "C" void _16_32_Bit_Timer_0A_Handler(void)
@@ -108,29 +108,29 @@ extern "C" void GPIO_Port_F_Handler(void)
 //     } 
 // }
 
-void pollTest(void)
+void adcSampled(uint16_t* samples, uint32_t count, void* context)
 {
-
-    (void)testAdc.getAdcSample(); 
-    readme = testAdc.getAdcSample();
-    testAdc.clearInterrupt();
+    if(count > 0)
+    {
+        *((volatile uint32_t*)context) = samples[count - 1];
+    }
 }
 
 extern "C" void SystemInit(void)
 {
     SystemControl::initializeGPIOHB();
-    SystemControl::initializeClock(_80MHz);
+    SystemControl::initializeClock<systemClock>();
 
-    greenLed.initialize((uint32_t)PF3::M1PWM7, output);
-    blueLed.initialize((uint32_t)PF2::GPIO, output); 
-    redLed.initialize((uint32_t)PF1::GPIO, output);
-    adcPin.initialize((uint32_t)PE3::AIN0, input);
+    greenLed.initialize<Pin<PF3, PF3::M1PWM7>>(output);
+    blueLed.initialize<Pin<PF2, PF2::GPIO>>(output); 
+    redLed.initialize<Pin<PF1, PF1::GPIO>>(output);
+    adcPin.initialize<Pin<PE3, PE3::AIN0>>(input);
 
     greenPwm.initializeSingle(7, module1, 0xFFFF, 0xFFFF/2, 0x1, countDirectionPwm::down, (uint32_t)ACTZERO::invertPwm, true, (uint32_t)pwmUnitClockDivisor::_64);
 
     testAdc.initializeModule((uint32_t)adcModule::module0, sequencerPriority, false, false);
 
-    adcResolution = Adc::getAdcResolution();
+    ain0Calibration.initialize(3300, 0, 65536);
 }
  
 int main(void)
@@ -138,15 +138,17 @@ int main(void)
     
     Nvic::disableInterrupts();
 
-    swtich1.initialize((uint32_t)PF4::GPIO, input, 3);
-    swtich2.initialize((uint32_t)PF0::GPIO, input, 3);
+    swtich1.initialize<Pin<PF4, PF4::GPIO>>(input, 3, interruptSense::bothEdges, switchChanged, &switch1Led);
+    swtich2.initialize<Pin<PF0, PF0::GPIO>>(input, 3, interruptSense::bothEdges, switchChanged, &switch2Led);
 
-    // myTimer.initializeForInterupt(periodic, shortTimer0, 80000000, down, concatenated, 3);
+    // myTimer.initializeForInterupt(periodic, shortTimer0, systemClock::ticks(1), down, concatenated, 3);
     // myTimer.enableTimer();
 
     Nvic::enableInterrupts();
 
-    testAdc.initializeForPolling((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::processor, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, pollTest);
+    volatile uint32_t lastSample = 0;
+
+    testAdc.initializeForInterrupt((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::processor, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, adcSampled, (void*)&lastSample, 4);
     testAdc.enableSampleSequencer();
     testAdc.initiateSampling();
 
@@ -156,9 +158,7 @@ int main(void)
     while(1)
     {
         // Nvic::wfi();
-        testAdc.pollStatus();
-        voltageValue = (3.3/(1<<adcResolution))*readme;
-        voltageValue = voltageValue;
+        milliVolts = ain0Calibration.convert(lastSample);
     }
 
 }
@@ -10,7 +10,13 @@
 #include "timer/generalPurposeTimer.h"
 #include "pwm/pwm.h"
 #include "adc/adc.h"
+#include "adc/adcCalibration.h"
 
+/**
+ * System clock of the example program, 80MHz from the 16MHz crystal on the
+ * launchpad.
+ */
+typedef ClockConfiguration<16000000, 80000000> systemClock;
 
 // Gpio blueLed;
 // Gpio redLed;
@@ -28,21 +28,26 @@
  */
 
 #include "pwm.h"
+#include "../systemControl/powerManager.h"
 
 /**
- * @brief empty constructor placeholder
+ * @brief Marks the object as holding no clock, so the destructor and a
+ *        re-initialization release nothing until one is acquired.
  */
 Pwm::Pwm()
 {
-
+    clockAcquired = false;
 }
 
 /**
- * @brief empty deconstructor placeholder
+ * @brief Releases the PWM module clock if the module was initialized.
  */
 Pwm::~Pwm()
 {
-
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::pwm, (0x1 << pwmModuleUsed), (uint32_t)clockGateMode::run);
+    }
 }
 
 /**
@@ -184,14 +189,17 @@ void Pwm::initializePair(uint32_t pwmPin, pwmModule module, uint32_t period, uin
  */
 void Pwm::initialize(pwmModule module, uint32_t period, countDirectionPwm countDir, bool enablePwmDiv, uint32_t divisor)
 {    
+    if(clockAcquired == true)
+    {
+        PowerManager::release(clockGatedPeripheral::pwm, (0x1 << pwmModuleUsed), (uint32_t)clockGateMode::run);
+    }
+
     baseAddress = pwm0BaseAddress + (module * 0x1000);
+    pwmModuleUsed = module;
     
     //0. Enable the clock for PWM
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCGCPWM_OFFSET)), (uint32_t)setORClear::set, module, 1, RW);
-    while(Register::getRegisterBitFieldStatus((volatile uint32_t*)(systemControlBase + PRPWM_OFFSET), module, 1, RO) == 0)
-    {
-        //Ready??
-    }
+    PowerManager::acquire(clockGatedPeripheral::pwm, (0x1 << module), (uint32_t)clockGateMode::run);
+    clockAcquired = true;
 
     // Clear count register by reseting PWM
 
@@ -186,6 +186,8 @@ class Pwm
     public:
         Pwm();
         ~Pwm();
+        Pwm(const Pwm&) = delete;
+        Pwm& operator=(const Pwm&) = delete;
 
         void initializeSingle(uint32_t pwmPin, pwmModule module, uint32_t period, uint32_t compA, uint32_t compB, countDirectionPwm countDir, uint32_t genOptions, bool enablePwmDiv, uint32_t divisor);
         void initializePair(uint32_t pwmPin, pwmModule module, uint32_t period, uint32_t compA, uint32_t compB, countDirectionPwm countDir, uint32_t genOptionsA, uint32_t genOptionsB, bool enablePwmDiv, uint32_t divisor);
@@ -196,6 +198,8 @@ class Pwm
 
         uint32_t baseAddress;
         uint32_t myPwmGen;
+        uint32_t pwmModuleUsed;
+        bool clockAcquired;
 
         static const uint32_t pwm0BaseAddress = 0x40028000;
         // static const uint32_t pwm1BaseAddress = 0x40029000;
@@ -0,0 +1,188 @@
+/**
+ * @file powerManager.cpp
+ * @brief TM4C123GH6PM Power Manager Definition
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+#include "powerManager.h"
+
+uint8_t PowerManager::referenceCount[numberOfModes][numberOfPeripherals][maxInstances];
+uint32_t PowerManager::gatedInstances[numberOfModes];
+
+const uint32_t PowerManager::gatingModeOffset[numberOfModes] = {RCGC_OFFSET, SCGC_OFFSET, DCGC_OFFSET};
+
+/*
+ * Offset of each peripheral's gating register relative to the first gating
+ * register of the mode, in the order of the clockGatedPeripheral enum.
+ */
+const uint32_t PowerManager::peripheralOffset[numberOfPeripherals] = {0x00, 0x04, 0x08, 0x0C, 0x14, 0x18, 0x1C, 0x20, 0x28, 0x34, 0x38, 0x3C, 0x40, 0x44, 0x58, 0x5C};
+
+/**
+ * @brief empty constructor placeholder
+ */
+PowerManager::PowerManager()
+{
+
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+PowerManager::~PowerManager()
+{
+
+}
+
+/**
+ * @brief Requests the clock of one or more instances of a peripheral.
+ * 
+ * @details Instances whose reference count goes from 0 to 1 are gated on with
+ *          one write per gating register. When run mode is requested this 
+ *          waits once, for every instance in \c instanceMask, on the 
+ *          peripheral ready register, after which the peripheral registers 
+ *          may be accessed.
+ * 
+ * @param peripheral type to clock.
+ * @param instanceMask bit n set requests instance n, e.g. 0x21 for GPIO port
+ *        A and F.
+ * @param modes ORed \c clockGateMode values the clock is needed in.
+ */
+void PowerManager::acquire(clockGatedPeripheral peripheral, uint32_t instanceMask, uint32_t modes)
+{
+    instanceMask &= ((0x1 << maxInstances) - 1);
+
+    uint32_t primask = Nvic::disableInterrupts();
+
+    for(uint32_t mode = 0; mode < numberOfModes; mode++)
+    {
+        if((modes & (0x1 << mode)) != 0)
+        {
+            uint32_t gateOn = 0;
+
+            for(uint32_t instance = 0; instance < maxInstances; instance++)
+            {
+                if(((instanceMask & (0x1 << instance)) != 0) && (referenceCount[mode][(uint32_t)peripheral][instance]++ == 0))
+                {
+                    gateOn |= (0x1 << instance);
+                }
+            }
+
+            if(gateOn != 0)
+            {
+                *((volatile uint32_t*)(systemControlBase + gatingModeOffset[mode] + peripheralOffset[(uint32_t)peripheral])) |= gateOn;
+                gatedInstances[mode] += __builtin_popcount(gateOn);
+            }
+        }
+    }
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    if((modes & (uint32_t)clockGateMode::run) != 0)
+    {
+        while(((*((volatile uint32_t*)(systemControlBase + PR_OFFSET + peripheralOffset[(uint32_t)peripheral]))) & instanceMask) != instanceMask)
+        {
+            //Ready?
+        }
+    }
+}
+
+/**
+ * @brief Releases the clock of one or more instances of a peripheral.
+ * 
+ * @details Instances whose reference count drops to 0 are gated off with one
+ *          write per gating register.
+ * 
+ * @param peripheral type to release.
+ * @param instanceMask bit n set releases instance n.
+ * @param modes ORed \c clockGateMode values to release, must match the modes 
+ *        the clock was acquired with.
+ */
+void PowerManager::release(clockGatedPeripheral peripheral, uint32_t instanceMask, uint32_t modes)
+{
+    uint32_t primask = Nvic::disableInterrupts();
+
+    for(uint32_t mode = 0; mode < numberOfModes; mode++)
+    {
+        if((modes & (0x1 << mode)) != 0)
+        {
+            uint32_t gateOff = 0;
+
+            for(uint32_t instance = 0; instance < maxInstances; instance++)
+            {
+                if(((instanceMask & (0x1 << instance)) != 0) && (referenceCount[mode][(uint32_t)peripheral][instance] != 0))
+                {
+                    if(--referenceCount[mode][(uint32_t)peripheral][instance] == 0)
+                    {
+                        gateOff |= (0x1 << instance);
+                    }
+                }
+            }
+
+            if(gateOff != 0)
+            {
+                *((volatile uint32_t*)(systemControlBase + gatingModeOffset[mode] + peripheralOffset[(uint32_t)peripheral])) &= ~gateOff;
+                gatedInstances[mode] -= __builtin_popcount(gateOff);
+            }
+        }
+    }
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+}
+
+/**
+ * @param peripheral type to query.
+ * @param instance of the peripheral.
+ * @param mode to query.
+ * 
+ * @return number of users currently holding the clock.
+ */
+uint32_t PowerManager::getReferenceCount(clockGatedPeripheral peripheral, uint32_t instance, clockGateMode mode)
+{
+    if(instance >= maxInstances)
+    {
+        return(0);
+    }
+
+    return(referenceCount[((uint32_t)mode) >> 1][(uint32_t)peripheral][instance]);
+}
+
+/**
+ * @brief Tells whether any peripheral instance holds a clock in a mode.
+ * 
+ * @param mode to query, a single \c clockGateMode value.
+ * 
+ * @return true when at least one instance is gated on for \c mode .
+ */
+bool PowerManager::hasUsers(clockGateMode mode)
+{
+    return(gatedInstances[((uint32_t)mode) >> 1] != 0);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file powerManager.h
+ * @brief TM4C123GH6PM Power Manager Declaration
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+
+/**
+ * @class PowerManager
+ * @brief TM4C123GH6PM Peripheral Clock Gating Manager
+ * 
+ * @section powerManagerDescription Power Manager Description
+ * 
+ * Every peripheral has a clock gating control register for run mode (RCGC), 
+ * sleep mode (SCGC) and deep-sleep mode (DCGC), plus a peripheral ready 
+ * register (PR). Instead of each driver setting its own RCGC bit, drivers ask
+ * the power manager for the clock. The power manager keeps a reference count
+ * per peripheral instance and per mode, so a peripheral shared by several 
+ * driver objects (e.g. one GPIO port used by several \c Gpio objects) stays 
+ * clocked until the last user releases it, at which point its clock is gated
+ * off again.
+ * 
+ * A group of instances of the same peripheral (e.g. GPIO ports A, B and F) is
+ * enabled with a single write per gating register and a single wait on the
+ * peripheral ready register.
+ * 
+ * Note that the sleep and deep-sleep gating registers are only used by the
+ * hardware when the \c ACG bit in the RCC register is set, otherwise the run 
+ * mode gating is used in every mode. SystemControl::enterLowPowerMode only 
+ * sets ACG when some peripheral has been acquired for the mode being 
+ * entered. A driver that acquires a sleep or deep-sleep clock therefore 
+ * opts the whole system into that gating, and every peripheral that has to
+ * keep running or wake the part, e.g. the wake up timer or GPIO port, must 
+ * then be acquired for that mode too.
+ * 
+ * @subsection powerManagerRegisterDescription Power Manager Register Description
+ * 
+ * All addresses given are relative to the System Control base address of 
+ * 0x400F.E000. Legacy registers not supported.
+ * 
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include "systemControl.h"
+
+/**
+ * Peripherals that have clock gating control.
+ */
+enum class clockGatedPeripheral : uint32_t {watchdog, timer, gpio, dma, hibernation, uart, ssi, i2c, usb, can, adc, analogComparator, pwm, qei, eeprom, wideTimer};
+
+/**
+ * Power modes a peripheral clock can be requested for. Can be ORed together.
+ */
+enum class clockGateMode : uint32_t {run = 0x1, sleep = 0x2, deepSleep = 0x4};
+
+class PowerManager
+{
+    public:
+        PowerManager();
+        ~PowerManager();
+
+        static void acquire(clockGatedPeripheral peripheral, uint32_t instanceMask, uint32_t modes);
+        static void release(clockGatedPeripheral peripheral, uint32_t instanceMask, uint32_t modes);
+        static uint32_t getReferenceCount(clockGatedPeripheral peripheral, uint32_t instance, clockGateMode mode);
+        static bool hasUsers(clockGateMode mode);
+
+    private:
+
+        static const uint32_t numberOfPeripherals = 16;
+        static const uint32_t maxInstances = 8;
+        static const uint32_t numberOfModes = 3;
+
+        static uint8_t referenceCount[numberOfModes][numberOfPeripherals][maxInstances];
+        static uint32_t gatedInstances[numberOfModes];
+
+        static const uint32_t RCGC_OFFSET = 0x600; //0x600 RCGCWD RW 0x0000.0000 Watchdog Timer Run Mode Clock Gating Control 337
+        static const uint32_t SCGC_OFFSET = 0x700; //0x700 SCGCWD RW 0x0000.0000 Watchdog Timer Sleep Mode Clock Gating Control 359
+        static const uint32_t DCGC_OFFSET = 0x800; //0x800 DCGCWD RW 0x0000.0000 Watchdog Timer Deep-Sleep Mode Clock Gating Control 381
+        static const uint32_t PR_OFFSET = 0xA00; //0xA00 PRWD RO 0x0000.0000 Watchdog Timer Peripheral Ready 403
+
+        static const uint32_t gatingModeOffset[numberOfModes];
+        static const uint32_t peripheralOffset[numberOfPeripherals];
+};
+
+#endif //POWER_MANAGER_H
@@ -28,6 +28,14 @@
  */
 
 #include "systemControl.h"
+#include "powerManager.h"
+
+uint32_t SystemControl::systemClockHz = piosc16MHz;
+void (*SystemControl::clockChangeNotifier[maxClockChangeNotifiers])(uint32_t systemClockHz, void* context);
+void* SystemControl::clockChangeContext[maxClockChangeNotifiers];
+uint32_t SystemControl::lastWakeLatencyCycles;
+uint32_t SystemControl::maxWakeLatencyCycles;
+uint32_t SystemControl::wakeCount;
 
 /**
  * @brief empty constructor placeholder
@@ -60,16 +68,46 @@ void SystemControl::initializeGPIOHB(void)
 }
 
 /**
- * @brief Initializes the PLL for system clock use
+ * @brief Initializes the PLL for system clock use from a 16MHz crystal.
  *
  * @param frequency of the new system clock.
  */ 
 void SystemControl::initializeClock(SYSDIV2 frequency)
+{
+	initializePll(_16MHz_XTAL, frequency);
+}
+
+/**
+ * @brief Changes the system clock at runtime.
+ * 
+ * @details The system clock is switched over to the main oscillator by 
+ *          bypassing the PLL, the divisor is changed and the PLL is put back
+ *          on the system clock once it reports lock. Interrupts are masked 
+ *          during the switch so no ISR runs with a half written divisor. Once
+ *          the new clock is running every registered clock change notifier is
+ *          called so drivers can recompute their clock dependent divisors. If
+ *          the PLL has not been initialized yet, this performs a full 
+ *          \c initializeClock.
+ * 
+ * @param frequency of the new system clock.
+ */
+void SystemControl::setSystemClock(SYSDIV2 frequency)
+{
+	changePllDivisor(_16MHz_XTAL, frequency);
+}
+
+/**
+ * @brief Initializes the PLL for system clock use
+ *
+ * @param xtal RCC XTAL value of the crystal on the main oscillator.
+ * @param divisor of the 400MHz PLL output, from 5 to 128.
+ */ 
+void SystemControl::initializePll(uint32_t xtal, uint32_t divisor)
 {
 	
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::set, 31, 1, RW); //0. Use RCC2.
 	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::set, 11, 1, RW); //1. Bypass PLL while initiializing
-	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC_OFFSET)), _16MHz_XTAL, 6, 5, RW); // 2. Select the crystal value and the oscillator source, configure for 16MHz crystal.
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC_OFFSET)), xtal, 6, 5, RW); // 2. Select the crystal value and the oscillator source.
 	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), MOSC, 4, 3, RW);  //Confgure for main oscillator source.
 	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::clear, 13, 1, RW); // 3. Activate PLL by clearing PWRDN.
 	
@@ -83,8 +121,8 @@ void SystemControl::initializeClock(SYSDIV2 frequency)
 	 */
 	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::set, 30, 1, RW);
 	
-	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), ((frequency - 1) & 0x01), 22, 1, RW);
-	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), ((frequency - 1) >> 1), 23, 6, RW);
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), ((divisor - 1) & 0x01), 22, 1, RW);
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), ((divisor - 1) >> 1), 23, 6, RW);
 
 	while((Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RIS_OFFSET)), 6, 1, RO)) == 0)  // 5. Wait for the PLL to lock by polling PLLRIS.
 	{
@@ -92,5 +130,242 @@ void SystemControl::initializeClock(SYSDIV2 frequency)
 	}
 	
 	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::clear, 11, 1, RW); // 6. Enable use of the PLL by clearing BYPASS.
+
+	systemClockHz = pllFrequencyHz / divisor;
+	notifyClockChange();
+}
+
+/**
+ * @brief Changes the PLL divisor of a running system clock.
+ * 
+ * @details See \c setSystemClock. Falls back to \c initializePll if the PLL
+ *          is not running yet.
+ * 
+ * @param xtal RCC XTAL value of the crystal on the main oscillator, only used 
+ *        if the PLL has to be initialized.
+ * @param divisor of the 400MHz PLL output, from 5 to 128.
+ */
+void SystemControl::changePllDivisor(uint32_t xtal, uint32_t divisor)
+{
+	if((Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), 31, 1, RW) == 0) || (Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), 13, 1, RW) == 1))
+	{
+		initializePll(xtal, divisor);
+		return;
+	}
+
+	uint32_t primask = Nvic::disableInterrupts();
+
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::set, 11, 1, RW); //Bypass PLL while changing the divisor
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), ((divisor - 1) & 0x01), 22, 1, RW);
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), ((divisor - 1) >> 1), 23, 6, RW);
+
+	while((Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + PLLSTAT_OFFSET)), 0, 1, RO)) == 0) // Wait for the PLL to report lock.
+	{
+
+	}
+
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), (uint32_t)setORClear::clear, 11, 1, RW); //Put the PLL back on the system clock
+
+	systemClockHz = pllFrequencyHz / divisor;
+
+	if(primask == 0)
+	{
+		Nvic::enableInterrupts();
+	}
+
+	notifyClockChange();
+}
+
+/**
+ * @brief Gets the current system clock frequency.
+ * 
+ * @return frequency of the system clock in Hz. 16MHz (PIOSC) if the clock has
+ *         not been initialized.
+ */
+uint32_t SystemControl::getSystemClockHz(void)
+{
+	return(systemClockHz);
+}
+
+/**
+ * @brief Registers a function to be called after every system clock change.
+ * 
+ * @param notifier function to call. It is given the new system clock in Hz 
+ *        and the \c context pointer.
+ * @param context pointer passed back to the notifier, generally the driver
+ *        object that owns the clock dependent divisor.
+ * 
+ * @return true if registered, false if all notifier slots are in use.
+ */
+bool SystemControl::registerClockChangeNotifier(void (*notifier)(uint32_t systemClockHz, void* context), void* context)
+{
+	for(uint32_t i = 0; i < maxClockChangeNotifiers; i++)
+	{
+		if(clockChangeNotifier[i] == 0)
+		{
+			clockChangeContext[i] = context;
+			clockChangeNotifier[i] = notifier;
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/**
+ * @brief Removes a clock change notifier.
+ * 
+ * @param notifier function that was registered.
+ * @param context pointer it was registered with.
+ */
+void SystemControl::unregisterClockChangeNotifier(void (*notifier)(uint32_t systemClockHz, void* context), void* context)
+{
+	for(uint32_t i = 0; i < maxClockChangeNotifiers; i++)
+	{
+		if((clockChangeNotifier[i] == notifier) && (clockChangeContext[i] == context))
+		{
+			clockChangeNotifier[i] = 0;
+			clockChangeContext[i] = 0;
+		}
+	}
+}
+
+/**
+ * @brief Calls every registered clock change notifier with the new system 
+ *        clock.
+ */
+void SystemControl::notifyClockChange(void)
+{
+	for(uint32_t i = 0; i < maxClockChangeNotifiers; i++)
+	{
+		if(clockChangeNotifier[i] != 0)
+		{
+			clockChangeNotifier[i](systemClockHz, clockChangeContext[i]);
+		}
+	}
+}
+
+/**
+ * @brief Selects the clock the system runs from while in deep-sleep.
+ * 
+ * @details The hardware switches to this clock when deep-sleep is entered and
+ *          back to the run mode clock configured in RCC/RCC2 on wake up. Use 
+ *          \c PIOSC or \c LFIOSC with a large divisor to trade wake up time 
+ *          for deep-sleep current.
+ * 
+ * @param source oscillator used in deep-sleep, \c PIOSC4 is not a valid 
+ *        deep-sleep source and is ignored.
+ * @param divisor clock divisor used in deep-sleep, from 1 to 64.
+ */
+void SystemControl::configureDeepSleepClock(OSCSRC source, uint32_t divisor)
+{
+	if((source == PIOSC4) || (divisor < 1) || (divisor > 64))
+	{
+		return;
+	}
+
+	*((volatile uint32_t*)(systemControlBase + DSLPCLKCFG_OFFSET)) = ((divisor - 1) << 23) | ((uint32_t)source << 4);
+}
+
+/**
+ * @brief Puts the processor to sleep or deep-sleep until an interrupt occurs.
+ * 
+ * @details Interrupts are masked around the WFI, so the wake up interrupt is 
+ *          not lost if it fires before the processor goes to sleep and its
+ *          handler only runs once the run mode clock is back. When some 
+ *          peripheral was acquired for the mode being entered through the 
+ *          \c PowerManager , the sleep or deep-sleep clock gating registers 
+ *          are enabled (RCC ACG) and only those peripherals keep their clock,
+ *          so the wake up source must be among them. Otherwise ACG is cleared
+ *          and every peripheral keeps its run mode clock. After a deep-sleep
+ *          the PLL is given time to lock again before returning.
+ * 
+ *          The number of processor cycles from the first instruction after 
+ *          the wake up to the return of this function, which includes the 
+ *          PLL relock, is recorded as the wake latency. Time spent by the 
+ *          hardware before the processor clock starts again is not counted.
+ * 
+ * @param mode low power mode to enter.
+ */
+void SystemControl::enterLowPowerMode(powerMode mode)
+{
+	Dwt::enableCycleCounter();
+
+	uint32_t primask = Nvic::disableInterrupts();
+
+	//Use SCGCn or DCGCn only when a driver asked for them, empty gating registers would stop the wake up source
+	bool gated = PowerManager::hasUsers((mode == powerMode::deepSleep) ? clockGateMode::deepSleep : clockGateMode::sleep);
+
+	Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC_OFFSET)), gated ? (uint32_t)setORClear::set : (uint32_t)setORClear::clear, 27, 1, RW);
+	Sbc::setSleepDeep(mode == powerMode::deepSleep);
+
+	Nvic::wfi();
+
+	uint32_t wakeCycle = Dwt::getCycleCount();
+
+	Sbc::setSleepDeep(false);
+
+	if((mode == powerMode::deepSleep) && (Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCC2_OFFSET)), 11, 1, RW) == 0))
+	{
+		while((Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + PLLSTAT_OFFSET)), 0, 1, RO)) == 0) // Wait for the PLL to report lock.
+		{
+
+		}
+	}
+
+	lastWakeLatencyCycles = Dwt::getCycleCount() - wakeCycle;
+
+	if(lastWakeLatencyCycles > maxWakeLatencyCycles)
+	{
+		maxWakeLatencyCycles = lastWakeLatencyCycles;
+	}
+
+	wakeCount++;
+
+	if(primask == 0)
+	{
+		Nvic::enableInterrupts();
+	}
+}
+
+/**
+ * @brief Gets the latency of the most recent wake up.
+ * 
+ * @return processor cycles from wake up until \c enterLowPowerMode returned.
+ */
+uint32_t SystemControl::getLastWakeLatency(void)
+{
+	return(lastWakeLatencyCycles);
 }
 
+/**
+ * @brief Gets the longest wake up latency seen.
+ * 
+ * @return processor cycles of the slowest wake up since the statistics were
+ *         last cleared.
+ */
+uint32_t SystemControl::getMaxWakeLatency(void)
+{
+	return(maxWakeLatencyCycles);
+}
+
+/**
+ * @brief Gets the number of wake ups.
+ * 
+ * @return number of times \c enterLowPowerMode returned since the statistics
+ *         were last cleared.
+ */
+uint32_t SystemControl::getWakeCount(void)
+{
+	return(wakeCount);
+}
+
+/**
+ * @brief Clears the wake up latency statistics.
+ */
+void SystemControl::clearWakeStatistics(void)
+{
+	lastWakeLatencyCycles = 0;
+	maxWakeLatencyCycles = 0;
+	wakeCount = 0;
+}
@@ -63,12 +63,25 @@
 
 #include "../register/register.h"
 #include "../corePeripherals/nvic/nvic.h"
+#include "../corePeripherals/sbc/sbc.h"
+#include "../corePeripherals/dwt/dwt.h"
 
 /**
  * Base address for the system control registers.
  */
 static const uint32_t systemControlBase = 0x400FE000;
 
+/**
+ * Frequency of the PLL output when the DIV400 divider is used.
+ */
+static const uint32_t pllFrequencyHz = 400000000;
+
+/**
+ * Frequency of the precision internal oscillator, the system clock source 
+ * out of reset.
+ */
+static const uint32_t piosc16MHz = 16000000;
+
 /**
  * System clocks that the PLL can be programmed to.
  */
@@ -103,7 +116,7 @@ enum SYSDIV2
     _3_77MHz = 106, _3_73MHz = 107, _3_70MHz = 108, _3_67MHz = 109,
     _3_63MHz = 110, _3_60MHz = 111, _3_57MHz = 112,_3_54MHz = 113,
     _3_50MHz = 114, _3_47MHz = 115, _3_44MHz = 116, _3_41MHz = 117,
-    _3_90MHz = 118, _3_36MHz = 119, _3_33MHz = 120, _3_30MHz = 121,
+    _3_39MHz = 118, _3_36MHz = 119, _3_33MHz = 120, _3_30MHz = 121,
     _3_27MHz = 122, _3_25MHz = 123, _3_22MHz = 124,_3_20MHz = 125,
     _3_17MHz = 126, _3_15MHz = 127, _3_12MHz = 128
 };
@@ -113,7 +126,7 @@ enum SYSDIV2
  */
 enum XTAL_VAL
 {
-    _4MHz_XTAL = 0x09u, _6MHz_XTAL = 0x0Bu, _8MHz_XTAL = 0x0Eu,
+    _4MHz_XTAL = 0x06u, _5MHz_XTAL = 0x09u, _6MHz_XTAL = 0x0Bu, _8MHz_XTAL = 0x0Eu,
     _10MHz_XTAL = 0x10u, _12MHz_XTAL = 0x11u, _16MHz_XTAL = 0x15u,
     _18MHz_XTAL = 0x17u, _20MHz_XTAL = 0x18u, _24MHz_XTAL = 0x19u,
     _25MHz_XTAL = 0x1Au
@@ -134,6 +147,88 @@ enum OSCSRC
     _32_768kHz = 0x7 //32.768-kHz external oscillator
 };
 
+/**
+ * Low power mode entered by \c SystemControl::enterLowPowerMode
+ */
+enum class powerMode
+{
+    sleep, deepSleep
+};
+
+/**
+ * @brief Gets the RCC XTAL field value for a crystal frequency.
+ * 
+ * @param crystalHz frequency of the crystal on the main oscillator in Hz.
+ * 
+ * @return XTAL field value, 0 if the crystal is not supported by the PLL.
+ */
+constexpr uint32_t crystalToXtal(uint32_t crystalHz)
+{
+    return((crystalHz == 4000000) ? 0x06u : (crystalHz == 4096000) ? 0x07u :
+        (crystalHz == 4915200) ? 0x08u : (crystalHz == 5000000) ? 0x09u :
+        (crystalHz == 5120000) ? 0x0Au : (crystalHz == 6000000) ? 0x0Bu :
+        (crystalHz == 6144000) ? 0x0Cu : (crystalHz == 7372800) ? 0x0Du :
+        (crystalHz == 8000000) ? 0x0Eu : (crystalHz == 8192000) ? 0x0Fu :
+        (crystalHz == 10000000) ? 0x10u : (crystalHz == 12000000) ? 0x11u :
+        (crystalHz == 12288000) ? 0x12u : (crystalHz == 13560000) ? 0x13u :
+        (crystalHz == 14318180) ? 0x14u : (crystalHz == 16000000) ? 0x15u :
+        (crystalHz == 16384000) ? 0x16u : (crystalHz == 18000000) ? 0x17u :
+        (crystalHz == 20000000) ? 0x18u : (crystalHz == 24000000) ? 0x19u :
+        (crystalHz == 25000000) ? 0x1Au : 0x00u);
+}
+
+/**
+ * @brief Compile time PLL clock configuration.
+ * 
+ * @details Computes the RCC2 SYSDIV2/SYSDIV2LSB divisor of the 400MHz PLL 
+ *          output that comes closest to \c targetHz, and the RCC XTAL value
+ *          for the crystal. Targets the PLL can not produce within 
+ *          \c toleranceHz, reserved divisors and unsupported crystals fail
+ *          to compile. The resulting clock is exported as \c frequencyHz and
+ *          \c ticks() converts a rate into clock cycles at compile time, so
+ *          timer loads, PWM periods and baud divisors become immediates.
+ * 
+ *          Example:
+ *          typedef ClockConfiguration<16000000, 80000000> systemClock;
+ *          SystemControl::initializeClock<systemClock>();
+ *          timer.initializeForPolling(periodic, shortTimer0, systemClock::ticks(1000), ...);
+ * 
+ * @tparam crystalHz frequency of the crystal on the main oscillator in Hz.
+ * @tparam targetHz wanted system clock in Hz.
+ * @tparam toleranceHz largest accepted difference between the wanted and the 
+ *         resulting system clock, 1% of the target by default.
+ */
+template<uint32_t crystalHz, uint32_t targetHz, uint32_t toleranceHz = targetHz/100>
+struct ClockConfiguration
+{
+    static_assert(targetHz > 0, "System clock target must not be zero");
+
+    static constexpr uint32_t xtal = crystalToXtal(crystalHz);
+    static constexpr uint32_t divisor = (pllFrequencyHz + (targetHz/2))/targetHz;
+    static constexpr uint32_t sysdiv2 = (divisor - 1) >> 1;
+    static constexpr uint32_t sysdiv2lsb = (divisor - 1) & 0x1;
+    static constexpr uint32_t frequencyHz = pllFrequencyHz/((divisor == 0) ? 1 : divisor);
+
+    static_assert(xtal != 0, "Crystal frequency is not supported by the PLL");
+    static_assert((divisor >= 5) && (divisor <= 128), "System clock target is out of the 3.125MHz to 80MHz PLL range");
+    static_assert(divisor != 7, "57.14MHz (divisor 7) is a reserved PLL setting");
+    static_assert(((frequencyHz > targetHz) ? (frequencyHz - targetHz) : (targetHz - frequencyHz)) <= toleranceHz, "PLL can not produce the system clock target within tolerance");
+
+    /**
+     * @brief Number of system clock cycles in one period of \c hz.
+     */
+    static constexpr uint32_t ticks(uint32_t hz)
+    {
+        return(frequencyHz/hz);
+    }
+};
+
+template<uint32_t crystalHz, uint32_t targetHz, uint32_t toleranceHz> constexpr uint32_t ClockConfiguration<crystalHz, targetHz, toleranceHz>::xtal;
+template<uint32_t crystalHz, uint32_t targetHz, uint32_t toleranceHz> constexpr uint32_t ClockConfiguration<crystalHz, targetHz, toleranceHz>::divisor;
+template<uint32_t crystalHz, uint32_t targetHz, uint32_t toleranceHz> constexpr uint32_t ClockConfiguration<crystalHz, targetHz, toleranceHz>::sysdiv2;
+template<uint32_t crystalHz, uint32_t targetHz, uint32_t toleranceHz> constexpr uint32_t ClockConfiguration<crystalHz, targetHz, toleranceHz>::sysdiv2lsb;
+template<uint32_t crystalHz, uint32_t targetHz, uint32_t toleranceHz> constexpr uint32_t ClockConfiguration<crystalHz, targetHz, toleranceHz>::frequencyHz;
+
 
 class SystemControl
 {
@@ -144,9 +239,37 @@ class SystemControl
 
         static void initializeGPIOHB(void);
         static void initializeClock(SYSDIV2 frequency);
+        static void setSystemClock(SYSDIV2 frequency);
+        template<class configuration> static void initializeClock(void);
+        template<class configuration> static void setSystemClock(void);
+        static uint32_t getSystemClockHz(void);
+
+        static bool registerClockChangeNotifier(void (*notifier)(uint32_t systemClockHz, void* context), void* context);
+        static void unregisterClockChangeNotifier(void (*notifier)(uint32_t systemClockHz, void* context), void* context);
+
+        static void configureDeepSleepClock(OSCSRC source, uint32_t divisor);
+        static void enterLowPowerMode(powerMode mode);
+        static uint32_t getLastWakeLatency(void);
+        static uint32_t getMaxWakeLatency(void);
+        static uint32_t getWakeCount(void);
+        static void clearWakeStatistics(void);
 
     private:
 
+        static void initializePll(uint32_t xtal, uint32_t divisor);
+        static void changePllDivisor(uint32_t xtal, uint32_t divisor);
+        static void notifyClockChange(void);
+
+        static uint32_t systemClockHz;
+
+        static const uint32_t maxClockChangeNotifiers = 8;
+        static void (*clockChangeNotifier[maxClockChangeNotifiers])(uint32_t systemClockHz, void* context);
+        static void* clockChangeContext[maxClockChangeNotifiers];
+
+        static uint32_t lastWakeLatencyCycles;
+        static uint32_t maxWakeLatencyCycles;
+        static uint32_t wakeCount;
+
         static const uint32_t RCC_OFFSET = 0x060; //RCC RW 0x078E.3AD1 Run-Mode Clock Configuration 254
         static const uint32_t RCC2_OFFSET = 0x070; //RCC2 RW 0x07C0.6810 Run-Mode Clock Configuration 2 260
         static const uint32_t RIS_OFFSET = 0x050; //0x050 RIS RO 0x0000.0000 Raw Interrupt Status 244
@@ -175,4 +298,26 @@ class SystemControl
         static const uint32_t GPIOHBCTL_OFFSET = 0x06C; //0x06C GPIOHBCTL RW 0x0000.7E00 GPIO High-Performance Bus Control 258
 };
 
+/**
+ * @brief Initializes the PLL for system clock use from a compile time clock 
+ *        configuration.
+ * 
+ * @tparam configuration \c ClockConfiguration to run the system clock at.
+ */
+template<class configuration> void SystemControl::initializeClock(void)
+{
+    initializePll(configuration::xtal, configuration::divisor);
+}
+
+/**
+ * @brief Changes the system clock at runtime to a compile time clock 
+ *        configuration.
+ * 
+ * @tparam configuration \c ClockConfiguration to run the system clock at.
+ */
+template<class configuration> void SystemControl::setSystemClock(void)
+{
+    changePllDivisor(configuration::xtal, configuration::divisor);
+}
+
 #endif //SYSTEM_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * @file adcOversamplerTest.cpp
+ * @brief Host Test of the ADC Oversampling Arithmetic
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+/*
+ * Checks the arithmetic AdcOversampler uses to turn sequences of 12-bit 
+ * results into 14 to 16-bit outputs: the extra bit range, the sequences per
+ * output, the accumulate and shift, and the noise free resolution. Built and
+ * run on the host with "make test". Only the constexpr helpers of the class
+ * are used, so no ADC code is linked.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../adc/adcOversampler.h"
+
+static uint32_t failures = 0;
+
+static void check(bool passed, const char* name)
+{
+    printf("%-48s %s\n", name, passed ? "pass" : "FAIL");
+
+    if(passed == false)
+    {
+        failures++;
+    }
+}
+
+/**
+ * @brief Runs one output through the accumulate and shift of the sampled 
+ *        callback, 8 results per sequence.
+ * 
+ * @param base result every sample has.
+ * @param raised number of samples that are \c base + 1, spread over the 
+ *        sequences.
+ * @param extraBits 2 to 4.
+ */
+static uint32_t oversample(uint32_t base, uint32_t raised, uint32_t extraBits)
+{
+    uint32_t sequences = AdcOversampler::sequencesPerOutput(extraBits);
+    uint32_t samples = sequences * AdcOversampler::samplesPerSequence;
+    uint32_t accumulator = 0;
+    uint32_t index = 0;
+
+    for(uint32_t s = 0; s < sequences; s++)
+    {
+        uint32_t sum = 0;
+
+        for(uint32_t i = 0; i < AdcOversampler::samplesPerSequence; i++)
+        {
+            //Bresenham spread of the raised samples over the output
+            uint32_t before = (index * raised) / samples;
+            uint32_t after = ((index + 1) * raised) / samples;
+
+            sum += base + (after - before);
+            index++;
+        }
+
+        accumulator += sum;
+    }
+
+    return(AdcOversampler::decimate(accumulator, extraBits));
+}
+
+static void testExtraBits(void)
+{
+    check((AdcOversampler::clampExtraBits(0) == 2) && (AdcOversampler::clampExtraBits(1) == 2), "Extra bits below 2 clamp to 2");
+    check((AdcOversampler::clampExtraBits(3) == 3) && (AdcOversampler::clampExtraBits(9) == 4), "Extra bits above 4 clamp to 4");
+
+    bool whole = true;
+
+    for(uint32_t requested = 0; requested <= 8; requested++)
+    {
+        uint32_t extraBits = AdcOversampler::clampExtraBits(requested);
+        uint32_t sequences = AdcOversampler::sequencesPerOutput(extraBits);
+
+        if((sequences == 0) || ((sequences * AdcOversampler::samplesPerSequence) != (0x1u << (2 * extraBits))))
+        {
+            whole = false;
+        }
+    }
+
+    check(whole, "Every output is 4^n results in whole sequences");
+    check((AdcOversampler::sequencesPerOutput(2) == 2) && (AdcOversampler::sequencesPerOutput(4) == 32), "Sequences per output for 14 and 16 bits");
+}
+
+static void testDecimation(void)
+{
+    bool fullScale = true;
+    bool steps = true;
+
+    for(uint32_t extraBits = AdcOversampler::minExtraBits; extraBits <= AdcOversampler::maxExtraBits; extraBits++)
+    {
+        uint32_t outputBits = 12 + extraBits;
+
+        //A full scale input uses the top of the output range and fits in it
+        uint32_t top = oversample(4095, 0, extraBits);
+
+        if((top != (4095u << extraBits)) || (top >= (0x1u << outputBits)))
+        {
+            fullScale = false;
+        }
+
+        //Every 2^n raised samples add one output LSB, a 2^-n step of the input
+        uint32_t stepSamples = 0x1u << extraBits;
+
+        for(uint32_t k = 0; k < stepSamples; k++)
+        {
+            if(oversample(2000, k * stepSamples, extraBits) != ((2000u << extraBits) + k))
+            {
+                steps = false;
+            }
+        }
+
+        if(oversample(2000, stepSamples - 1, extraBits) != (2000u << extraBits))
+        {
+            steps = false;
+        }
+    }
+
+    check(fullScale, "Full scale input fills 12 + n bits");
+    check(steps, "Dithered input resolves 2^-n LSB steps");
+}
+
+static void testNoiseFreeBits(void)
+{
+    check(AdcOversampler::noiseFreeResolution(16, 0) == 16, "No spread keeps every bit");
+    check(AdcOversampler::noiseFreeResolution(16, 1) == 15, "Spread of 1 LSB costs 1 bit");
+    check((AdcOversampler::noiseFreeResolution(16, 2) == 14) && (AdcOversampler::noiseFreeResolution(16, 3) == 14), "Spread of 2 - 3 LSBs costs 2 bits");
+    check((AdcOversampler::noiseFreeResolution(14, 4) == 11) && (AdcOversampler::noiseFreeResolution(14, 7) == 11), "Spread of 4 - 7 LSBs costs 3 bits");
+    check(AdcOversampler::noiseFreeResolution(16, 0xFFFF) == 0, "Full scale spread leaves no bits");
+
+    bool matches = true;
+
+    for(uint32_t spread = 0; spread < 0x10000; spread++)
+    {
+        uint32_t bits = 0;
+
+        while((spread >> bits) != 0)
+        {
+            bits++;
+        }
+
+        if(AdcOversampler::spreadBits(spread) != bits)
+        {
+            matches = false;
+        }
+    }
+
+    check(matches, "Spread bits for every 16-bit spread");
+}
+
+int main(void)
+{
+    testExtraBits();
+    testDecimation();
+    testNoiseFreeBits();
+
+    printf("\n%u failure(s)\n", (unsigned)failures);
+
+    return((failures == 0) ? 0 : 1);
+}
@@ -0,0 +1,510 @@
+/**
+ * @file dspTest.cpp
+ * @brief Host Test Harness for the Fixed Point DSP Filters
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+/*
+ * Checks the filters in dsp/ bit for bit against straightforward reference
+ * implementations and reports their throughput. Built and run on the host 
+ * with "make test". 
+ * 
+ * Without __ARM_FEATURE_DSP the Dsp primitives compile to their portable C 
+ * versions, so the host run checks the block structure, state handling and
+ * rounding of every filter. The same file can be linked for the target with
+ * semihosting to check the DSP instruction paths, cycleCount then reads the 
+ * DWT cycle counter.
+ * 
+ * Throughput is given in samples per cycle. On an x86 host a cycle is a time 
+ * stamp counter tick, elsewhere on the host a nanosecond, so host figures 
+ * are only good for comparing the filters with each other.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../dsp/dsp.h"
+#include "../dsp/fir.h"
+#include "../dsp/biquad.h"
+#include "../dsp/cic.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__ARM_ARCH_7EM__)
+#include <time.h>
+#endif
+
+static const uint32_t signalLength = 2048;
+static const uint32_t benchmarkLength = 4096;
+static const uint32_t benchmarkRepeats = 64;
+
+static uint32_t failures = 0;
+static uint32_t randomState = 0x12345678;
+
+/**
+ * @brief xorshift32, the same sequence on every host.
+ */
+static uint32_t nextRandom(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return(randomState);
+}
+
+/**
+ * @brief Random Q15 signal with full scale steps, so saturation is exercised.
+ */
+static void fillQ15(q15_t* signal, uint32_t length)
+{
+    for(uint32_t i = 0; i < length; i++)
+    {
+        uint32_t r = nextRandom();
+
+        if((r & 0xF) == 0)
+        {
+            signal[i] = ((r & 0x10) != 0) ? 32767 : -32768;
+        }
+
+        else
+        {
+            signal[i] = (q15_t)(r >> 16);
+        }
+    }
+}
+
+/**
+ * @brief Length of the next chunk a signal is fed in, 1 to 97 samples.
+ */
+static uint32_t nextChunk(uint32_t remaining)
+{
+    uint32_t chunk = 1 + (nextRandom() % 97);
+    return((chunk < remaining) ? chunk : remaining);
+}
+
+static uint64_t cycleCount(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return(__rdtsc());
+#elif defined(__ARM_ARCH_7EM__)
+    *((volatile uint32_t*)0xE000EDFC) |= (0x1 << 24); //DEMCR TRCENA
+    *((volatile uint32_t*)0xE0001000) |= 0x1; //DWT_CTRL CYCCNTENA
+    return(*((volatile uint32_t*)0xE0001004));
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return(((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec);
+#endif
+}
+
+static void check(bool passed, const char* name)
+{
+    printf("%-48s %s\n", name, passed ? "pass" : "FAIL");
+
+    if(passed == false)
+    {
+        failures++;
+    }
+}
+
+static q15_t referenceSaturate16(int64_t value)
+{
+    return((q15_t)((value > 32767) ? 32767 : ((value < -32768) ? -32768 : value)));
+}
+
+static q31_t referenceSaturate32(int64_t value)
+{
+    return((q31_t)((value > INT32_MAX) ? INT32_MAX : ((value < INT32_MIN) ? INT32_MIN : value)));
+}
+
+/**
+ * @brief Every 12-bit code through the packed conversion against 
+ *        code * 16 - 32768, with an odd count for the unpaired tail.
+ */
+static void testAdcToQ15(void)
+{
+    static uint16_t codes[4095];
+    static q15_t converted[4095];
+    bool passed = true;
+
+    for(uint32_t i = 0; i < 4095; i++)
+    {
+        codes[i] = (uint16_t)(i + 1);
+    }
+
+    Dsp::adcToQ15(codes, converted, 4095);
+
+    for(uint32_t i = 0; i < 4095; i++)
+    {
+        passed = passed && (converted[i] == (q15_t)((int32_t)codes[i] * 16 - 32768));
+    }
+
+    check(passed, "Dsp::adcToQ15 all codes");
+}
+
+/**
+ * @brief FirQ15::process against processReference, fed in random chunks.
+ */
+static void testFirQ15(void)
+{
+    static const uint32_t tapCounts[] = {1, 2, 7, 32, 33};
+    static const uint32_t blockSizes[] = {1, 5, 64};
+    static q15_t input[signalLength];
+    static q15_t output[signalLength];
+    static q15_t expected[signalLength];
+    static q15_t coefficients[33];
+    static q15_t state[33 - 1 + 64];
+    static q15_t referenceState[33 - 1 + 64];
+    char name[64];
+
+    for(uint32_t t = 0; t < sizeof(tapCounts) / sizeof(tapCounts[0]); t++)
+    {
+        for(uint32_t b = 0; b < sizeof(blockSizes) / sizeof(blockSizes[0]); b++)
+        {
+            FirQ15 filter;
+            FirQ15 reference;
+
+            fillQ15(coefficients, tapCounts[t]);
+            fillQ15(input, signalLength);
+            filter.initialize(coefficients, tapCounts[t], state, blockSizes[b]);
+            reference.initialize(coefficients, tapCounts[t], referenceState, blockSizes[b]);
+
+            for(uint32_t i = 0; i < signalLength;)
+            {
+                uint32_t chunk = nextChunk(signalLength - i);
+
+                filter.process(&input[i], &output[i], chunk);
+                reference.processReference(&input[i], &expected[i], chunk);
+                i += chunk;
+            }
+
+            bool passed = true;
+
+            for(uint32_t i = 0; i < signalLength; i++)
+            {
+                passed = passed && (output[i] == expected[i]);
+            }
+
+            snprintf(name, sizeof(name), "FirQ15 %u taps block %u", (unsigned)tapCounts[t], (unsigned)blockSizes[b]);
+            check(passed, name);
+        }
+    }
+}
+
+/**
+ * @brief FirQ31::process, fed in random chunks, against a direct 
+ *        convolution over the whole signal.
+ */
+static void testFirQ31(void)
+{
+    static const uint32_t tapCount = 17;
+    static q31_t input[signalLength];
+    static q31_t output[signalLength];
+    static q31_t coefficients[tapCount];
+    static q31_t state[tapCount - 1 + 32];
+    FirQ31 filter;
+    bool passed = true;
+
+    for(uint32_t k = 0; k < tapCount; k++)
+    {
+        coefficients[k] = (q31_t)nextRandom() >> 3;
+    }
+
+    for(uint32_t i = 0; i < signalLength; i++)
+    {
+        input[i] = (q31_t)nextRandom();
+    }
+
+    filter.initialize(coefficients, tapCount, state, 32);
+
+    for(uint32_t i = 0; i < signalLength;)
+    {
+        uint32_t chunk = nextChunk(signalLength - i);
+
+        filter.process(&input[i], &output[i], chunk);
+        i += chunk;
+    }
+
+    for(uint32_t n = 0; n < signalLength; n++)
+    {
+        int64_t accumulator = 0;
+
+        for(uint32_t k = 0; (k < tapCount) && (k <= n); k++)
+        {
+            accumulator += (int32_t)(((int64_t)coefficients[k] * input[n - k]) >> 32);
+        }
+
+        passed = passed && (output[n] == referenceSaturate32(accumulator * 2));
+    }
+
+    check(passed, "FirQ31 17 taps");
+}
+
+/**
+ * @brief Two section Butterworth low pass at 0.05 fs, fed in random chunks 
+ *        and run section by section, against the same sections run sample 
+ *        by sample. Then full scale noise, which saturates.
+ */
+static void testBiquad(void)
+{
+    //Q31 scaled by 2^-1, a1 and a2 negated
+    static const biquadCoefficients sections[2] = 
+    {
+        {20440642, 40881285, 20440642, 1588788093, -596808838},
+        {23497607, 46995214, 23497607, 1826396544, -846645149}
+    };
+    static const uint32_t postShift = 1;
+    static q31_t input[signalLength];
+    static q31_t output[signalLength];
+    static q31_t state[8];
+    const char* names[2] = {"BiquadQ31 2 sections, step", "BiquadQ31 2 sections, saturating noise"};
+
+    for(uint32_t run = 0; run < 2; run++)
+    {
+        BiquadQ31 filter;
+        q31_t history[2][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}};
+        bool passed = true;
+
+        for(uint32_t i = 0; i < signalLength; i++)
+        {
+            input[i] = (run == 0) ? (((i / 256) & 0x1) ? 0x40000000 : -0x40000000) : (q31_t)nextRandom();
+        }
+
+        filter.initialize(sections, 2, state, postShift);
+
+        for(uint32_t i = 0; i < signalLength;)
+        {
+            uint32_t chunk = nextChunk(signalLength - i);
+
+            filter.process(&input[i], &output[i], chunk);
+            i += chunk;
+        }
+
+        for(uint32_t n = 0; n < signalLength; n++)
+        {
+            q31_t value = input[n];
+
+            for(uint32_t s = 0; s < 2; s++)
+            {
+                const biquadCoefficients& c = sections[s];
+                q31_t* h = history[s];
+                int64_t accumulator = ((int64_t)c.b0 * value) + ((int64_t)c.b1 * h[0]) + ((int64_t)c.b2 * h[1]) + ((int64_t)c.a1 * h[2]) + ((int64_t)c.a2 * h[3]);
+                q31_t result = referenceSaturate32(accumulator >> (31 - postShift));
+
+                h[1] = h[0];
+                h[0] = value;
+                h[3] = h[2];
+                h[2] = result;
+                value = result;
+            }
+
+            passed = passed && (output[n] == value);
+        }
+
+        check(passed, names[run]);
+    }
+}
+
+/**
+ * @brief CicDecimator, fed in random chunks, against the input convolved 
+ *        with a length \c decimation boxcar \c order times, taken at every 
+ *        \c decimation th input and scaled by the same power of 2.
+ */
+static void testCic(void)
+{
+    static const uint32_t decimations[] = {1, 2, 5, 8, 16};
+    static q15_t input[signalLength];
+    static q15_t output[signalLength];
+    static int64_t response[4 * 15 + 1];
+    char name[64];
+
+    for(uint32_t order = 1; order <= CicDecimator::maxOrder; order++)
+    {
+        for(uint32_t d = 0; d < sizeof(decimations) / sizeof(decimations[0]); d++)
+        {
+            uint32_t decimation = decimations[d];
+            uint32_t decimationBits = 0;
+
+            while((0x1u << decimationBits) < decimation)
+            {
+                decimationBits++;
+            }
+
+            //Wrapping 32-bit arithmetic is only exact within the documented gain
+            if((order * decimationBits) > 16)
+            {
+                continue;
+            }
+
+            uint32_t responseLength = 1;
+            response[0] = 1;
+
+            for(uint32_t stage = 0; stage < order; stage++)
+            {
+                uint32_t newLength = responseLength + decimation - 1;
+
+                for(uint32_t i = newLength; i-- > 0;)
+                {
+                    int64_t sum = 0;
+
+                    for(uint32_t j = 0; j < decimation; j++)
+                    {
+                        if((i >= j) && ((i - j) < responseLength))
+                        {
+                            sum += response[i - j];
+                        }
+                    }
+
+                    response[i] = sum;
+                }
+
+                responseLength = newLength;
+            }
+
+            CicDecimator filter;
+            uint32_t outputCount = 0;
+            bool passed = true;
+
+            fillQ15(input, signalLength);
+            filter.initialize(order, decimation);
+
+            for(uint32_t i = 0; i < signalLength;)
+            {
+                uint32_t chunk = nextChunk(signalLength - i);
+
+                outputCount += filter.process(&input[i], &output[outputCount], chunk);
+                i += chunk;
+            }
+
+            passed = (outputCount == (signalLength / decimation));
+
+            for(uint32_t m = 0; passed && (m < outputCount); m++)
+            {
+                uint32_t n = (m + 1) * decimation - 1;
+                int64_t sum = 0;
+
+                for(uint32_t j = 0; (j < responseLength) && (j <= n); j++)
+                {
+                    sum += response[j] * input[n - j];
+                }
+
+                passed = (output[m] == referenceSaturate16(sum >> (order * decimationBits)));
+            }
+
+            snprintf(name, sizeof(name), "CicDecimator order %u decimation %u", (unsigned)order, (unsigned)decimation);
+            check(passed, name);
+        }
+    }
+}
+
+static void report(const char* name, uint64_t cycles)
+{
+    double samples = (double)benchmarkLength * benchmarkRepeats;
+
+    printf("%-48s %8.4f samples/cycle %8.1f cycles/sample\n", name, samples / (double)cycles, (double)cycles / samples);
+}
+
+/**
+ * @brief Times each filter over the same block, repeated.
+ */
+static void benchmark(void)
+{
+    static q15_t input[benchmarkLength];
+    static q15_t output[benchmarkLength];
+    static q31_t input31[benchmarkLength];
+    static q31_t output31[benchmarkLength];
+    static q15_t coefficients[32];
+    static q15_t state[32 - 1 + benchmarkLength];
+    static q31_t state31[8];
+    static const biquadCoefficients sections[2] = 
+    {
+        {20440642, 40881285, 20440642, 1588788093, -596808838},
+        {23497607, 46995214, 23497607, 1826396544, -846645149}
+    };
+    FirQ15 fir;
+    BiquadQ31 biquad;
+    CicDecimator cic;
+    uint64_t start;
+
+    fillQ15(input, benchmarkLength);
+    fillQ15(coefficients, 32);
+    Dsp::q15ToQ31(input, input31, benchmarkLength);
+
+    printf("\n");
+
+    fir.initialize(coefficients, 32, state, benchmarkLength);
+    start = cycleCount();
+
+    for(uint32_t r = 0; r < benchmarkRepeats; r++)
+    {
+        fir.process(input, output, benchmarkLength);
+    }
+
+    report("FirQ15::process 32 taps", cycleCount() - start);
+
+    fir.initialize(coefficients, 32, state, benchmarkLength);
+    start = cycleCount();
+
+    for(uint32_t r = 0; r < benchmarkRepeats; r++)
+    {
+        fir.processReference(input, output, benchmarkLength);
+    }
+
+    report("FirQ15::processReference 32 taps", cycleCount() - start);
+
+    biquad.initialize(sections, 2, state31, 1);
+    start = cycleCount();
+
+    for(uint32_t r = 0; r < benchmarkRepeats; r++)
+    {
+        biquad.process(input31, output31, benchmarkLength);
+    }
+
+    report("BiquadQ31 2 sections", cycleCount() - start);
+
+    cic.initialize(4, 16);
+    start = cycleCount();
+
+    for(uint32_t r = 0; r < benchmarkRepeats; r++)
+    {
+        cic.process(input, output, benchmarkLength);
+    }
+
+    report("CicDecimator order 4 decimation 16", cycleCount() - start);
+}
+
+int main(void)
+{
+    testAdcToQ15();
+    testFirQ15();
+    testFirQ31();
+    testBiquad();
+    testCic();
+    benchmark();
+
+    printf("\n%u failure(s)\n", (unsigned)failures);
+
+    return((failures == 0) ? 0 : 1);
+}
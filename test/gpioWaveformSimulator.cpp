@@ -0,0 +1,240 @@
+/**
+ * @file gpioWaveformSimulator.cpp
+ * @brief Host Timeline Simulator for the Gpio Waveform Generator
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+#include "gpioWaveformSimulator.h"
+
+/**
+ * @brief Starts with all pins low and the default loop cost.
+ */
+GpioWaveformSimulator::GpioWaveformSimulator()
+{
+    initialize(0, defaultLoopCycles);
+}
+
+/**
+ * @brief empty deconstructor placeholder
+ */
+GpioWaveformSimulator::~GpioWaveformSimulator()
+{
+
+}
+
+/**
+ * @brief Sets the pin state before the first step and the loop cost.
+ * 
+ * @param initialPins port pin values before playback.
+ * @param loopCycles shortest time between two stores.
+ */
+void GpioWaveformSimulator::initialize(uint32_t initialPins, uint32_t loopCycles)
+{
+    (*this).initialPins = initialPins;
+    (*this).loopCycles = loopCycles;
+    report = waveformReport();
+    timeline.clear();
+}
+
+/**
+ * @brief Plays a table against the loop model and records the timeline.
+ * 
+ * @param steps table to play.
+ * @param stepCount number of steps in the table.
+ */
+void GpioWaveformSimulator::play(const waveformStep* steps, uint32_t stepCount)
+{
+    uint32_t pins = initialPins;
+    uint32_t deadline = 0;
+    uint32_t store = 0;
+
+    report = waveformReport();
+    timeline.clear();
+
+    for(uint32_t i = 0; i < stepCount; i++)
+    {
+        if((i == 0) || (deadline > (store + loopCycles)))
+        {
+            store = deadline;
+        }
+
+        else
+        {
+            store += loopCycles;
+        }
+
+        uint32_t late = store - deadline;
+
+        if(late > report.maxLateCycles)
+        {
+            report.maxLateCycles = late;
+        }
+
+        if(late > GpioWaveform::lateTolerance)
+        {
+            report.lateSteps++;
+        }
+
+        pins = (pins & ~steps[i].mask) | (steps[i].value & steps[i].mask);
+
+        if(timeline.empty() || (timeline.back().pins != pins))
+        {
+            simulatedEdge edge = {store, pins};
+            timeline.push_back(edge);
+        }
+
+        if(i < (stepCount - 1))
+        {
+            report.requestedCycles += steps[i].delayCycles;
+        }
+
+        deadline += steps[i].delayCycles;
+    }
+
+    report.achievedCycles = store;
+}
+
+/**
+ * @brief Gets the timing of the last simulated playback.
+ * 
+ * @return the same fields GpioWaveform::getReport gives on the board.
+ */
+waveformReport GpioWaveformSimulator::getReport(void)
+{
+    return(report);
+}
+
+/**
+ * @brief Gets the pin changes of the last simulated playback.
+ * 
+ * @return one entry per store that changed a pin, in time order.
+ */
+const std::vector<simulatedEdge>& GpioWaveformSimulator::getTimeline(void)
+{
+    return(timeline);
+}
+
+/**
+ * @brief Gets the pin values at a point of the timeline.
+ * 
+ * @param cycle cycles after the first step deadline.
+ * 
+ * @return port pin values.
+ */
+uint32_t GpioWaveformSimulator::getPinsAt(uint32_t cycle)
+{
+    uint32_t pins = initialPins;
+
+    for(uint32_t i = 0; (i < timeline.size()) && (timeline[i].cycle <= cycle); i++)
+    {
+        pins = timeline[i].pins;
+    }
+
+    return(pins);
+}
+
+/**
+ * @brief Checks that one pin changes exactly at the given cycles and at no
+ *        other time.
+ * 
+ * @param pin pin number, 0 to 7.
+ * @param edgeCycles expected cycles of the changes, in time order.
+ * @param edgeCount number of expected changes.
+ * 
+ * @return true when the timeline matches.
+ */
+bool GpioWaveformSimulator::checkEdges(uint32_t pin, const uint32_t* edgeCycles, uint32_t edgeCount)
+{
+    uint32_t level = (initialPins >> pin) & 0x1;
+    uint32_t found = 0;
+
+    for(uint32_t i = 0; i < timeline.size(); i++)
+    {
+        uint32_t newLevel = (timeline[i].pins >> pin) & 0x1;
+
+        if(newLevel == level)
+        {
+            continue;
+        }
+
+        if((found >= edgeCount) || (timeline[i].cycle != edgeCycles[found]))
+        {
+            return(false);
+        }
+
+        level = newLevel;
+        found++;
+    }
+
+    return(found == edgeCount);
+}
+
+/**
+ * @brief Writes the timeline as a Value Change Dump, one wire per pin.
+ * 
+ * @param file open for writing.
+ * @param clockMHz system clock the cycles are counted in, for the 1ns 
+ *        timescale.
+ */
+void GpioWaveformSimulator::writeVcd(FILE* file, uint32_t clockMHz)
+{
+    fprintf(file, "$timescale 1ns $end\n$scope module gpio $end\n");
+
+    for(uint32_t pin = 0; pin < 8; pin++)
+    {
+        fprintf(file, "$var wire 1 %c pin%u $end\n", (char)('!' + pin), (unsigned)pin);
+    }
+
+    fprintf(file, "$upscope $end\n$enddefinitions $end\n#0\n");
+
+    for(uint32_t pin = 0; pin < 8; pin++)
+    {
+        fprintf(file, "%u%c\n", (unsigned)((initialPins >> pin) & 0x1), (char)('!' + pin));
+    }
+
+    uint32_t pins = initialPins;
+    unsigned long long lastTime = 0;
+
+    for(uint32_t i = 0; i < timeline.size(); i++)
+    {
+        unsigned long long time = (unsigned long long)timeline[i].cycle * 1000 / clockMHz;
+
+        if(time != lastTime)
+        {
+            fprintf(file, "#%llu\n", time);
+            lastTime = time;
+        }
+
+        for(uint32_t pin = 0; pin < 8; pin++)
+        {
+            if((((pins ^ timeline[i].pins) >> pin) & 0x1) != 0)
+            {
+                fprintf(file, "%u%c\n", (unsigned)((timeline[i].pins >> pin) & 0x1), (char)('!' + pin));
+            }
+        }
+
+        pins = timeline[i].pins;
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file gpioWaveformSimulator.h
+ * @brief Host Timeline Simulator for the Gpio Waveform Generator
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/**
+ * @class GpioWaveformSimulator
+ * @brief Host Timeline Simulator for GpioWaveform Tables
+ * 
+ * @section gpioWaveformSimulatorDescription Gpio Waveform Simulator Description
+ * 
+ * Plays a \c waveformStep table on the host against a cycle model of the 
+ * GpioWaveform playback loop and records the resulting pin timeline, so a 
+ * table built by a protocol encoder can be checked before it runs on the 
+ * board. 
+ * 
+ * The model follows the loop in gpioWaveform.cpp: step deadlines are 
+ * absolute, the first one is time 0 and every step adds its delayCycles, 
+ * and a step is stored at its deadline or \c loopCycles after the previous
+ * store, whichever is later. Each store changes only the pins in the step 
+ * mask, as a masked GPIODATA store does. The report has the same fields and 
+ * meaning as GpioWaveform::getReport, so simulated and measured playbacks 
+ * can be compared directly.
+ * 
+ * \c loopCycles is the shortest time between two stores. It can be 
+ * measured on the board by playing a table of zero delays, 
+ * achievedCycles / (stepCount - 1) of its report.
+ */
+
+#ifndef GPIO_WAVEFORM_SIMULATOR_H
+#define GPIO_WAVEFORM_SIMULATOR_H
+
+#include <stdio.h>
+#include <vector>
+#include "../gpio/gpioWaveform.h"
+
+/**
+ * Pin state of the port from \c cycle until the next edge.
+ */
+struct simulatedEdge
+{
+    uint32_t cycle; //Cycles after the first step deadline
+    uint32_t pins; //Port pin values
+};
+
+class GpioWaveformSimulator
+{
+    public:
+        GpioWaveformSimulator();
+        ~GpioWaveformSimulator();
+
+        void initialize(uint32_t initialPins, uint32_t loopCycles);
+        void play(const waveformStep* steps, uint32_t stepCount);
+        waveformReport getReport(void);
+
+        const std::vector<simulatedEdge>& getTimeline(void);
+        uint32_t getPinsAt(uint32_t cycle);
+        bool checkEdges(uint32_t pin, const uint32_t* edgeCycles, uint32_t edgeCount);
+        void writeVcd(FILE* file, uint32_t clockMHz);
+
+        static const uint32_t defaultLoopCycles = 10;
+
+    private:
+
+        uint32_t initialPins;
+        uint32_t loopCycles;
+        waveformReport report;
+        std::vector<simulatedEdge> timeline;
+};
+
+#endif //GPIO_WAVEFORM_SIMULATOR_H
@@ -0,0 +1,222 @@
+/**
+ * @file gpioWaveformTest.cpp
+ * @brief Host Test of Gpio Waveform Tables
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+/*
+ * Runs waveform tables through the GpioWaveformSimulator and checks the 
+ * resulting timelines. Built and run on the host with "make test". Passing
+ * a file name writes the UART frame timeline to it as a VCD.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "gpioWaveformSimulator.h"
+
+static const uint32_t systemClockHz = 80000000;
+static const uint32_t baudRate = 115200;
+
+static uint32_t failures = 0;
+
+static void check(bool passed, const char* name)
+{
+    printf("%-48s %s\n", name, passed ? "pass" : "FAIL");
+
+    if(passed == false)
+    {
+        failures++;
+    }
+}
+
+/**
+ * @brief Cycle of the start of a UART bit, rounded so the frame does not 
+ *        drift.
+ */
+static uint32_t bitStart(uint32_t bit)
+{
+    return((uint32_t)(((uint64_t)bit * systemClockHz + (baudRate / 2)) / baudRate));
+}
+
+/**
+ * @brief Encodes one 8N1 UART frame on a pin, start bit, data LSB first 
+ *        and stop bit.
+ * 
+ * @return number of steps, 10.
+ */
+static uint32_t encodeUartFrame(uint8_t data, uint32_t pin, waveformStep* steps)
+{
+    for(uint32_t bit = 0; bit < 10; bit++)
+    {
+        uint32_t level = (bit == 0) ? 0 : ((bit == 9) ? 1 : ((data >> (bit - 1)) & 0x1));
+
+        steps[bit].mask = 0x1 << pin;
+        steps[bit].value = level << pin;
+        steps[bit].delayCycles = bitStart(bit + 1) - bitStart(bit);
+    }
+
+    return(10);
+}
+
+/**
+ * @brief A UART frame plays on time and decodes back to the byte.
+ */
+static void testUartFrame(const char* vcdFile)
+{
+    waveformStep steps[10];
+    GpioWaveformSimulator simulator;
+    uint32_t stepCount = encodeUartFrame(0xA7, 1, steps);
+
+    simulator.initialize(0x2, GpioWaveformSimulator::defaultLoopCycles);
+    simulator.play(steps, stepCount);
+
+    waveformReport report = simulator.getReport();
+
+    check((report.lateSteps == 0) && (report.maxLateCycles == 0), "UART frame, no late steps");
+    check((report.requestedCycles == bitStart(9)) && (report.achievedCycles == report.requestedCycles), "UART frame, achieved matches requested");
+
+    uint32_t decoded = 0;
+
+    for(uint32_t bit = 1; bit < 9; bit++)
+    {
+        uint32_t middle = (bitStart(bit) + bitStart(bit + 1)) / 2;
+        decoded |= ((simulator.getPinsAt(middle) >> 1) & 0x1) << (bit - 1);
+    }
+
+    bool framed = (((simulator.getPinsAt(bitStart(0) + 1) >> 1) & 0x1) == 0) && (((simulator.getPinsAt(bitStart(9) + 1) >> 1) & 0x1) == 1);
+
+    check(framed && (decoded == 0xA7), "UART frame, decodes to 0xA7");
+
+    //Start bit, 0xA7 = 1010 0111 sent LSB first, stop bit
+    uint32_t levels[10] = {0, 1, 1, 1, 0, 0, 1, 0, 1, 1};
+    uint32_t edges[10];
+    uint32_t edgeCount = 0;
+    uint32_t level = 1;
+
+    for(uint32_t bit = 0; bit < 10; bit++)
+    {
+        if(levels[bit] != level)
+        {
+            edges[edgeCount++] = bitStart(bit);
+            level = levels[bit];
+        }
+    }
+
+    check(simulator.checkEdges(1, edges, edgeCount), "UART frame, edges on the bit boundaries");
+
+    if(vcdFile != 0)
+    {
+        FILE* file = fopen(vcdFile, "w");
+
+        if(file != 0)
+        {
+            simulator.writeVcd(file, systemClockHz / 1000000);
+            fclose(file);
+        }
+    }
+}
+
+/**
+ * @brief Masked stores leave the other pins of the port alone.
+ */
+static void testMaskedStores(void)
+{
+    waveformStep steps[4] = 
+    {
+        {0x01, 0x01, 100}, //pin 0 high
+        {0x08, 0xFF, 100}, //pin 3 high, other bits of the value ignored
+        {0x01, 0x00, 100}, //pin 0 low
+        {0x09, 0x00, 0}    //pin 0 and 3 low
+    };
+    GpioWaveformSimulator simulator;
+
+    simulator.initialize(0x42, GpioWaveformSimulator::defaultLoopCycles);
+    simulator.play(steps, 4);
+
+    bool passed = (simulator.getPinsAt(0) == 0x43) && (simulator.getPinsAt(100) == 0x4B) && (simulator.getPinsAt(200) == 0x4A) && (simulator.getPinsAt(300) == 0x42);
+
+    check(passed, "Masked stores keep the other pins");
+}
+
+/**
+ * @brief Steps closer than the loop cost play late and the report says so.
+ */
+static void testDenseTable(void)
+{
+    waveformStep steps[20];
+    GpioWaveformSimulator simulator;
+    const uint32_t loopCycles = 10;
+
+    for(uint32_t i = 0; i < 20; i++)
+    {
+        steps[i].mask = 0x1;
+        steps[i].value = i & 0x1;
+        steps[i].delayCycles = 2;
+    }
+
+    simulator.initialize(0, loopCycles);
+    simulator.play(steps, 20);
+
+    waveformReport report = simulator.getReport();
+
+    check(report.requestedCycles == 19 * 2, "Dense table, requested cycles");
+    check(report.achievedCycles == 19 * loopCycles, "Dense table, paced by the loop");
+    //Step n is stored n * (loopCycles - 2) cycles late, so all but the first are past the tolerance
+    check((report.maxLateCycles == 19 * (loopCycles - 2)) && (report.lateSteps == 19), "Dense table, late steps reported");
+}
+
+/**
+ * @brief A table of zero delays measures the loop cost, as on the board.
+ */
+static void testLoopCalibration(void)
+{
+    waveformStep steps[9];
+    GpioWaveformSimulator simulator;
+
+    for(uint32_t i = 0; i < 9; i++)
+    {
+        steps[i].mask = 0x4;
+        steps[i].value = (i & 0x1) << 2;
+        steps[i].delayCycles = 0;
+    }
+
+    simulator.initialize(0, 13);
+    simulator.play(steps, 9);
+
+    check((simulator.getReport().achievedCycles / 8) == 13, "Zero delay table measures the loop cost");
+}
+
+int main(int argc, char** argv)
+{
+    testUartFrame((argc > 1) ? argv[1] : 0);
+    testMaskedStores();
+    testDenseTable();
+    testLoopCalibration();
+
+    printf("\n%u failure(s)\n", (unsigned)failures);
+
+    return((failures == 0) ? 0 : 1);
+}
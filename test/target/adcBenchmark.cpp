@@ -0,0 +1,417 @@
+/**
+ * @file adcBenchmark.cpp
+ * @brief On Target Adc Benchmarks
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+/*
+ * Adc trigger and streaming timings on the LaunchPad, see benchmark.h.
+ */
+
+#include "benchmark.h"
+#include "../../corePeripherals/nvic/nvic.h"
+#include "../../adc/adc.h"
+
+static const uint32_t latencyRepeats = 100;
+static const uint32_t latencyTimeout = 100000; //cycles
+
+static const uint32_t streamLength = 512;
+static const uint32_t streamRateHz = 200000;
+
+static uint16_t streamBuffer[streamLength];
+static volatile uint32_t streamCallbackDelay = 0; //cycles
+
+static const uint32_t jitterRateHz = 10000;
+static const uint32_t jitterSamples = 1000;
+
+static volatile uint32_t jitterCount = 0;
+static volatile uint32_t jitterFirstCycle = 0;
+static volatile uint32_t jitterLastCycle = 0;
+static volatile uint32_t jitterMinCycles = 0xFFFFFFFF;
+static volatile uint32_t jitterMaxCycles = 0;
+
+static volatile bool sampleDone = false;
+static volatile uint32_t sampleCycle = 0;
+
+/**
+ * @brief Polling action, stamps the end of the sequence.
+ */
+static void sequenceDone(void)
+{
+    sampleCycle = Dwt::getCycleCount();
+    sampleDone = true;
+}
+
+/**
+ * @brief Pin interrupt callback of the software trigger path.
+ * @param context the Adc to start.
+ */
+static void startSampling(void* context)
+{
+    (*((Adc*)context)).initiateSampling();
+}
+
+/**
+ * @brief Times rising edges of a pin to the end of the sequence they start.
+ * 
+ * @param edge output pin whose rising edge starts the sequence.
+ * @param converter polled sequencer started by the edge.
+ * @param minCycles shortest latency.
+ * @param maxCycles longest latency.
+ * 
+ * @return sum of the latencies, 0 if a sequence did not complete.
+ */
+static uint32_t measureTriggerLatency(Gpio& edge, Adc& converter, uint32_t* minCycles, uint32_t* maxCycles)
+{
+    uint32_t total = 0;
+
+    *minCycles = 0xFFFFFFFF;
+    *maxCycles = 0;
+
+    for(uint32_t r = 0; r < latencyRepeats; r++)
+    {
+        sampleDone = false;
+
+        uint32_t start = Dwt::getCycleCount();
+        edge.write(1);
+
+        while((sampleDone == false) && ((Dwt::getCycleCount() - start) < latencyTimeout))
+        {
+            converter.pollStatus();
+        }
+
+        if(sampleDone == false)
+        {
+            return(0);
+        }
+
+        uint32_t cycles = sampleCycle - start;
+
+        total += cycles;
+        *minCycles = (cycles < *minCycles) ? cycles : *minCycles;
+        *maxCycles = (cycles > *maxCycles) ? cycles : *maxCycles;
+
+        converter.clearInterrupt();
+        converter.getAdcSample();
+        edge.write(0);
+        edge.interruptClear();
+        waitCycles(1000);
+    }
+
+    return(total);
+}
+
+/**
+ * @brief Edge to end of conversion latency of a sequence started by the 
+ *        GPIOADCCTL hardware trigger against one started from the pin 
+ *        interrupt handler.
+ * 
+ * @details PB0 triggers sequencer 3 of ADC0 in hardware, measured with 
+ *          interrupts masked so no handler runs. PB1 interrupts and its 
+ *          callback starts sequencer 2 with ADCPSSI. Both sample AIN0 once
+ *          and are polled for the end of the sequence, so both figures 
+ *          include the conversion.
+ */
+void adcTriggerLatencyBenchmark(void)
+{
+    Gpio analogInput;
+    Gpio hardwareEdge;
+    Gpio softwareEdge;
+    Adc hardwareTriggered;
+    Adc softwareTriggered;
+    uint32_t sequencerPriority = (uint32_t)ssPriority0::third|(uint32_t)ssPriority1::second|(uint32_t)ssPriority2::first|(uint32_t)ssPriority3::zeroth;
+    uint32_t minCycles = 0;
+    uint32_t maxCycles = 0;
+
+    analogInput.initialize<Pin<PE3, PE3::AIN0>>(input);
+    hardwareEdge.initialize<Pin<PB0, PB0::GPIO>>(output);
+    hardwareEdge.write(0);
+
+    hardwareTriggered.initializeModule((uint32_t)adcModule::module0, sequencerPriority, (uint32_t)hardwareAvg::none, (uint32_t)phaseDelay::_0_0);
+    hardwareTriggered.initializeForPolling((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::processor, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, sequenceDone);
+    hardwareTriggered.attachGpioTrigger(hardwareEdge, interruptSense::risingEdge);
+    hardwareTriggered.enableSampleSequencer();
+
+    softwareTriggered.acquireModule((uint32_t)adcModule::module0);
+    softwareTriggered.initializeForPolling((uint32_t)sampleSequencer::SS2, (uint32_t)ssTriggerSource::processor, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, sequenceDone);
+    softwareTriggered.enableSampleSequencer();
+    softwareEdge.initialize<Pin<PB1, PB1::GPIO>>(output, 0, interruptSense::risingEdge, startSampling, &softwareTriggered);
+    softwareEdge.write(0);
+
+    printf("Adc edge to sample latency, AIN0\n");
+
+    uint32_t primask = Nvic::disableInterrupts();
+    uint32_t hardware = measureTriggerLatency(hardwareEdge, hardwareTriggered, &minCycles, &maxCycles);
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    check(hardware != 0, "Every PB0 edge starts a sequence in hardware");
+    reportCycles("GPIOADCCTL trigger, average", hardware, latencyRepeats);
+    reportValue("GPIOADCCTL trigger, best", minCycles, "cycles");
+    reportValue("GPIOADCCTL trigger, worst", maxCycles, "cycles");
+
+    hardwareEdge.disableTriggers();
+
+    uint32_t software = measureTriggerLatency(softwareEdge, softwareTriggered, &minCycles, &maxCycles);
+
+    check(software != 0, "Every PB1 edge starts a sequence from the ISR");
+    reportCycles("interrupt handler trigger, average", software, latencyRepeats);
+    reportValue("interrupt handler trigger, best", minCycles, "cycles");
+    reportValue("interrupt handler trigger, worst", maxCycles, "cycles");
+
+    if((hardware != 0) && (software > hardware))
+    {
+        reportCycles("latency saved by the hardware trigger", software - hardware, latencyRepeats);
+    }
+
+    //The callback context is about to go out of scope
+    softwareEdge.initialize<Pin<PB1, PB1::GPIO>>(output, 0, interruptSense::risingEdge, 0, 0);
+    printf("\n");
+}
+
+/**
+ * @brief Stream callback, optionally slower than a half buffer to force 
+ *        overruns.
+ */
+static void streamBlockReady(uint16_t* samples, uint32_t count, void* context)
+{
+    (void)samples;
+    (void)count;
+    (void)context;
+
+    waitCycles(streamCallbackDelay);
+}
+
+/**
+ * @brief Lets a stream run for a while.
+ * 
+ * @param converter streaming Adc.
+ * @param windowCycles cycles to run.
+ * @param overruns overruns during the window.
+ * 
+ * @return samples delivered during the window.
+ */
+static uint32_t runStream(Adc& converter, uint32_t windowCycles, uint32_t* overruns)
+{
+    uint32_t blocks = converter.getStreamBlockCount();
+    uint32_t overrunsBefore = converter.getStreamOverrunCount();
+
+    waitCycles(windowCycles);
+
+    *overruns = converter.getStreamOverrunCount() - overrunsBefore;
+
+    return((converter.getStreamBlockCount() - blocks) * (streamLength / 2));
+}
+
+/**
+ * @brief Sustained rate and overrun recovery of a timer triggered μDMA 
+ *        stream.
+ * 
+ * @details ADC0 sequencer 3 streams AIN0 at 200 ksps into a 512 sample 
+ *          ping-pong buffer. The delivered sample count over half a second
+ *          must match the timer rate without overruns. Then the callback is
+ *          made slower than a half buffer, which must be counted as 
+ *          overruns, and once it is fast again the re-armed stream must 
+ *          deliver the full rate again.
+ */
+void adcStreamBenchmark(void)
+{
+    Gpio analogInput;
+    Adc converter;
+    GeneralPurposeTimer trigger;
+    uint32_t sequencerPriority = (uint32_t)ssPriority0::third|(uint32_t)ssPriority1::second|(uint32_t)ssPriority2::first|(uint32_t)ssPriority3::zeroth;
+    uint32_t clockHz = SystemControl::getSystemClockHz();
+    uint32_t window = clockHz / 2;
+    uint32_t overruns = 0;
+
+    analogInput.initialize<Pin<PE3, PE3::AIN0>>(input);
+    converter.initializeModule((uint32_t)adcModule::module0, sequencerPriority, (uint32_t)hardwareAvg::none, (uint32_t)phaseDelay::_0_0);
+    converter.initializeForStreaming((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::timer, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, streamBuffer, streamLength, streamBlockReady, 0, 2);
+
+    printf("Adc uDMA stream, AIN0\n");
+
+    streamCallbackDelay = 0;
+    uint32_t rateHz = converter.startFixedRateSampling(trigger, shortTimer1, streamRateHz);
+    uint32_t expected = rateHz / 2;
+    uint32_t delivered = runStream(converter, window, &overruns);
+
+    reportValue("timer rate", rateHz, "samples/s");
+    reportValue("sustained rate", 2 * delivered, "samples/s");
+    reportValue("overruns, fast callback", overruns, "overruns");
+    check((delivered + (expected / 100) >= expected) && (delivered <= expected + (expected / 100)), "Sustained rate within 1% of the timer");
+    check(overruns == 0, "No overruns with a fast callback");
+
+    //Three half buffers of work per half buffer, both halves fill first
+    streamCallbackDelay = (uint32_t)(((uint64_t)clockHz * 3 * (streamLength / 2)) / rateHz);
+    runStream(converter, window, &overruns);
+    streamCallbackDelay = 0;
+
+    reportValue("overruns, slow callback", overruns, "overruns");
+    check(overruns > 0, "A slow callback is counted as overruns");
+
+    waitCycles(clockHz / 100); //Let the last slow callback finish
+    delivered = runStream(converter, window, &overruns);
+
+    reportValue("sustained rate after the overruns", 2 * delivered, "samples/s");
+    check((delivered + (expected / 100) >= expected) && (overruns == 0), "The re-armed stream runs at full rate again");
+
+    trigger.disableTimer();
+    converter.stopStreaming();
+    printf("\n");
+}
+
+/**
+ * @brief Sequencer interrupt callback, records the spread of the intervals
+ *        between timer triggered samples.
+ */
+static void jitterSampled(uint16_t* samples, uint32_t count, void* context)
+{
+    uint32_t now = Dwt::getCycleCount();
+
+    (void)samples;
+    (void)count;
+    (void)context;
+
+    if(jitterCount >= jitterSamples)
+    {
+        return;
+    }
+
+    if(jitterCount == 0)
+    {
+        jitterFirstCycle = now;
+    }
+
+    else
+    {
+        uint32_t interval = now - jitterLastCycle;
+
+        if(interval < jitterMinCycles)
+        {
+            jitterMinCycles = interval;
+        }
+
+        if(interval > jitterMaxCycles)
+        {
+            jitterMaxCycles = interval;
+        }
+    }
+
+    jitterLastCycle = now;
+    jitterCount++;
+}
+
+/**
+ * @brief Jitter and maximum rate of timer triggered sampling.
+ * 
+ * @details ADC0 sequencer 3 is triggered by a timer at 10 kHz and its 
+ *          interrupt stamps each sample. The spread of the intervals bounds
+ *          the trigger jitter from above, it includes the interrupt entry 
+ *          jitter. A rate above \c getMaxSequenceRateHz must be clamped to 
+ *          it, and a μDMA stream at that rate must deliver every sample 
+ *          without FIFO overflows. Re-initializing the timer for something 
+ *          else must clear its trigger rate.
+ */
+void adcFixedRateBenchmark(void)
+{
+    Gpio analogInput;
+    GeneralPurposeTimer trigger;
+    uint32_t sequencerPriority = (uint32_t)ssPriority0::third|(uint32_t)ssPriority1::second|(uint32_t)ssPriority2::first|(uint32_t)ssPriority3::zeroth;
+    uint32_t clockHz = SystemControl::getSystemClockHz();
+    uint32_t overruns = 0;
+
+    analogInput.initialize<Pin<PE3, PE3::AIN0>>(input);
+
+    printf("Adc fixed rate sampling, AIN0\n");
+
+    {
+        Adc converter;
+        uint32_t timeout = clockHz;
+
+        jitterCount = 0;
+        jitterMinCycles = 0xFFFFFFFF;
+        jitterMaxCycles = 0;
+
+        converter.initializeModule((uint32_t)adcModule::module0, sequencerPriority, (uint32_t)hardwareAvg::none, (uint32_t)phaseDelay::_0_0);
+        converter.initializeForInterrupt((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::timer, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, jitterSampled, 0, 1);
+
+        uint32_t rateHz = converter.startFixedRateSampling(trigger, shortTimer1, jitterRateHz);
+        uint32_t period = clockHz / rateHz;
+
+        while((jitterCount < jitterSamples) && (timeout > 0))
+        {
+            waitCycles(1000);
+            timeout = (timeout > 1000) ? (timeout - 1000) : 0;
+        }
+
+        trigger.disableTimer();
+
+        reportValue("trigger rate", rateHz, "samples/s");
+        reportValue("expected interval", period, "cycles");
+        reportValue("shortest interval", jitterMinCycles, "cycles");
+        reportValue("longest interval", jitterMaxCycles, "cycles");
+        check(jitterCount == jitterSamples, "Every timer trigger produced a sample");
+        uint32_t meanInterval = (jitterCount < 2) ? 0 : (jitterLastCycle - jitterFirstCycle) / (jitterCount - 1);
+
+        reportValue("mean interval", meanInterval, "cycles");
+        check((meanInterval + 1 >= period) && (meanInterval <= period + 1), "Mean interval matches the timer load");
+        check((jitterCount == jitterSamples) && (jitterMaxCycles - jitterMinCycles < 100), "Trigger jitter under 100 cycles");
+    }
+
+    {
+        Adc converter;
+
+        converter.initializeModule((uint32_t)adcModule::module0, sequencerPriority, (uint32_t)hardwareAvg::none, (uint32_t)phaseDelay::_0_0);
+        converter.initializeForStreaming((uint32_t)sampleSequencer::SS3, (uint32_t)ssTriggerSource::timer, (uint32_t)ssInputSrc0::AIN0, (uint32_t)ssControl0::END0|(uint32_t)ssControl0::IE0, streamBuffer, streamLength, streamBlockReady, 0, 2);
+        converter.resetStatistics();
+
+        streamCallbackDelay = 0;
+        uint32_t maxRateHz = converter.getMaxSequenceRateHz();
+        uint32_t rateHz = converter.startFixedRateSampling(trigger, shortTimer1, 2 * maxRateHz);
+        uint32_t expected = rateHz / 2;
+        uint32_t delivered = runStream(converter, clockHz / 2, &overruns);
+        adcStatistics counters = converter.getStatistics();
+
+        trigger.disableTimer();
+        converter.stopStreaming();
+
+        reportValue("maximum sequence rate", maxRateHz, "samples/s");
+        reportValue("rate at twice the maximum", rateHz, "samples/s");
+        reportValue("sustained rate", 2 * delivered, "samples/s");
+        reportValue("FIFO overflows", counters.overflowCount, "overflows");
+        check((rateHz <= maxRateHz) && (rateHz == trigger.getTriggerRateHz()), "Rate clamped to the maximum sequence rate");
+        check((delivered + (expected / 100) >= expected) && (delivered <= expected + (expected / 100)), "Sustained maximum rate within 1% of the timer");
+        check((overruns == 0) && (counters.overflowCount == 0), "No overruns or overflows at the maximum rate");
+    }
+
+    trigger.initializeForPolling(periodic, shortTimer1, clockHz, down, concatenated, 0);
+    check(trigger.getTriggerRateHz() == 0, "Re-initializing the timer clears its trigger rate");
+
+    printf("\n");
+}
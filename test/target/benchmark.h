@@ -0,0 +1,74 @@
+/**
+ * @file benchmark.h
+ * @brief On Target Benchmark Harness
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ */
+
+/*
+ * Benchmarks that need the hardware, driver timings measured with the DWT 
+ * cycle counter on the TM4C123G LaunchPad. 
+ * Built with "make benchmark" into benchmark.elf and run under the debugger,
+ * results are printed with semihosting, so the program halts without a 
+ * debugger attached.
+ * 
+ * Each benchmark prints one line per figure and checks the behavior it 
+ * relies on. Cycle figures are per operation with the loop overhead taken
+ * out, measured with interrupts masked unless the figure is an interrupt 
+ * path. They depend on the compiler flags of the driver objects.
+ * 
+ * LaunchPad connections: port B pins PB0 - PB7 are driven as outputs, 
+ * nothing may drive them. PB6 and PB7 are tied to PD0 and PD1 through R9 
+ * and R10, which stay inputs. The blue LED (PF2) is toggled. AIN0 (PE3) is 
+ * sampled, it may be left open.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../../corePeripherals/dwt/dwt.h"
+#include "../../systemControl/systemControl.h"
+
+/**
+ * System clock of the benchmarks, 80MHz from the 16MHz crystal.
+ */
+typedef ClockConfiguration<16000000, 80000000> benchmarkClock;
+
+uint32_t measureEmptyLoop(uint32_t repeats);
+void waitCycles(uint32_t cycles);
+void reportCycles(const char* name, uint32_t cycles, uint32_t operations);
+void reportValue(const char* name, uint32_t value, const char* unit);
+void check(bool passed, const char* name);
+
+void gpioAccessBenchmark(void);
+void gpioPortBenchmark(void);
+void gpioDispatchBenchmark(void);
+void gpioInterruptSenseBenchmark(void);
+void adcTriggerLatencyBenchmark(void);
+void adcStreamBenchmark(void);
+void adcFixedRateBenchmark(void);
+
+#endif //BENCHMARK_H
@@ -0,0 +1,158 @@
+/**
+ * @file benchmarkMain.cpp
+ * @brief On Target Benchmark Runner
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+/*
+ * Entry point of benchmark.elf, sets the system clock and runs every
+ * benchmark of test/target once.
+ */
+
+#include "benchmark.h"
+#include "../../corePeripherals/nvic/nvic.h"
+
+extern "C" void initialise_monitor_handles(void);
+
+static uint32_t failures = 0;
+
+/**
+ * These functions further help eliminate unwanted exceptions
+ */
+
+extern "C" void __cxa_pure_virtual() 
+{ 
+    while(1); 
+}
+
+void __gnu_cxx::__verbose_terminate_handler()
+{
+    while(1);
+}
+
+/**
+ * @brief Cycles of a loop with an empty body, subtracted from the loops 
+ *        timing an operation.
+ * 
+ * @param repeats loop iterations.
+ * 
+ * @return cycles of the whole loop.
+ */
+uint32_t measureEmptyLoop(uint32_t repeats)
+{
+    uint32_t start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < repeats; i++)
+    {
+        __asm__ volatile("" ::: "memory");
+    }
+
+    return(Dwt::getCycleCount() - start);
+}
+
+/**
+ * @brief Busy waits.
+ * 
+ * @param cycles processor cycles to wait.
+ */
+void waitCycles(uint32_t cycles)
+{
+    uint32_t start = Dwt::getCycleCount();
+
+    while((Dwt::getCycleCount() - start) < cycles);
+}
+
+/**
+ * @brief Prints the cycles of one operation with one decimal.
+ * 
+ * @param name of the figure.
+ * @param cycles of all operations, without the loop overhead.
+ * @param operations number of operations timed.
+ */
+void reportCycles(const char* name, uint32_t cycles, uint32_t operations)
+{
+    uint32_t tenths = (uint32_t)((((uint64_t)cycles * 10) + (operations / 2)) / operations);
+
+    printf("%-48s %6u.%u cycles\n", name, (unsigned)(tenths / 10), (unsigned)(tenths % 10));
+}
+
+/**
+ * @brief Prints a measured figure.
+ * 
+ * @param name of the figure.
+ * @param value measured.
+ * @param unit of \c value .
+ */
+void reportValue(const char* name, uint32_t value, const char* unit)
+{
+    printf("%-48s %8u %s\n", name, (unsigned)value, unit);
+}
+
+/**
+ * @brief Prints and counts the result of a check.
+ * 
+ * @param passed result of the check.
+ * @param name of the check.
+ */
+void check(bool passed, const char* name)
+{
+    printf("%-48s %s\n", name, passed ? "pass" : "FAIL");
+
+    if(passed == false)
+    {
+        failures++;
+    }
+}
+
+extern "C" void SystemInit(void)
+{
+    SystemControl::initializeGPIOHB();
+    SystemControl::initializeClock<benchmarkClock>();
+}
+
+int main(void)
+{
+    initialise_monitor_handles();
+    Dwt::enableCycleCounter();
+    Nvic::enableInterrupts();
+
+    printf("System clock %u Hz\n\n", (unsigned)SystemControl::getSystemClockHz());
+
+    gpioAccessBenchmark();
+    gpioPortBenchmark();
+    gpioDispatchBenchmark();
+    gpioInterruptSenseBenchmark();
+    adcTriggerLatencyBenchmark();
+    adcStreamBenchmark();
+    adcFixedRateBenchmark();
+
+    printf("\n%u failure(s)\n", (unsigned)failures);
+
+    while(1)
+    {
+        Nvic::wfi();
+    }
+}
@@ -0,0 +1,416 @@
+/**
+ * @file gpioBenchmark.cpp
+ * @brief On Target Gpio Benchmarks
+ * @author Matthew Hardenburgh
+ * @version 0.1
+ * @date 3/21/2020
+ * @copyright Matthew Hardenburgh 2020
+ * 
+ * @section license LICENSE
+ * 
+ * TM4C123GH6PM Drivers
+ * Copyright (C) 2020  Matthew Hardenburgh
+ * mdhardenburgh@protonmail.com
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see https://www.gnu.org/licenses/.
+ * 
+ */
+
+/*
+ * Gpio and GpioPort timings on the LaunchPad, see benchmark.h.
+ */
+
+#include "benchmark.h"
+#include "../../corePeripherals/nvic/nvic.h"
+#include "../../gpio/gpio.h"
+#include "../../gpio/gpioPort.h"
+
+static const uint32_t accessRepeats = 1000;
+static const uint32_t portBPins = 8;
+static const uint32_t dispatchRepeats = 100;
+static const uint32_t portB = 1;
+static const uint32_t pulseCount = 100;
+static const uint32_t pulseHalfPeriod = 400; //cycles, a 100kHz train at 80MHz
+
+static volatile uint32_t callbackCount = 0;
+
+/**
+ * @brief Pin interrupt callback of the benchmarks, counts the calls.
+ */
+static void countCallback(void* context)
+{
+    (void)context;
+    callbackCount++;
+}
+
+static const uint32_t portFData = 0x4005D000 + 0x3FC; //GPIODATA of port F, every pin
+
+/**
+ * @brief Pin read before GPIODATA address masking, a bit field read of the 
+ *        whole GPIODATA register.
+ */
+static uint32_t readModifyWriteRead(uint32_t pin)
+{
+    return(Register::getRegisterBitFieldStatus((volatile uint32_t*)portFData, pin, 1, RW));
+}
+
+/**
+ * @brief Pin write before GPIODATA address masking, a read-modify-write of 
+ *        the whole GPIODATA register.
+ */
+static void readModifyWriteWrite(uint32_t pin, uint32_t value)
+{
+    Register::setRegisterBitFieldStatus((volatile uint32_t*)portFData, value, pin, 1, RW);
+}
+
+/**
+ * @brief Gpio read, write and toggle through the pin's GPIODATA alias 
+ *        against the read-modify-write of the whole GPIODATA register they 
+ *        replaced, and the toggle rate of both.
+ */
+void gpioAccessBenchmark(void)
+{
+    Gpio blueLed;
+    Gpio redLed;
+
+    blueLed.initialize<Pin<PF2, PF2::GPIO>>(output);
+    redLed.initialize<Pin<PF1, PF1::GPIO>>(output);
+
+    printf("Gpio access, PF2\n");
+
+    uint32_t primask = Nvic::disableInterrupts();
+    uint32_t overhead = measureEmptyLoop(accessRepeats);
+    uint32_t start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        blueLed.write(i & 0x1);
+    }
+
+    uint32_t maskedWrite = Dwt::getCycleCount() - start - overhead;
+    start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        readModifyWriteWrite(2, i & 0x1);
+    }
+
+    uint32_t oldWrite = Dwt::getCycleCount() - start - overhead;
+    volatile uint32_t level = 0;
+    start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        level = blueLed.read();
+    }
+
+    uint32_t maskedRead = Dwt::getCycleCount() - start - overhead;
+    start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        level = readModifyWriteRead(2);
+    }
+
+    uint32_t oldRead = Dwt::getCycleCount() - start - overhead;
+    start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        blueLed.toggle();
+    }
+
+    uint32_t maskedToggle = Dwt::getCycleCount() - start;
+    start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        readModifyWriteWrite(2, readModifyWriteRead(2) ^ 0x1);
+    }
+
+    uint32_t oldToggle = Dwt::getCycleCount() - start;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    (void)level;
+
+    reportCycles("write, masked store", maskedWrite, accessRepeats);
+    reportCycles("write, read-modify-write", oldWrite, accessRepeats);
+    reportCycles("read, masked load", maskedRead, accessRepeats);
+    reportCycles("read, bit field read", oldRead, accessRepeats);
+    reportCycles("toggle, masked", maskedToggle - overhead, accessRepeats);
+    reportCycles("toggle, read-modify-write", oldToggle - overhead, accessRepeats);
+
+    //A toggle loop changes the pin once per iteration, loop included
+    uint32_t clockHz = SystemControl::getSystemClockHz();
+
+    reportValue("toggle rate in a loop, masked", (uint32_t)(((uint64_t)clockHz * accessRepeats) / maskedToggle), "toggles/s");
+    reportValue("toggle rate in a loop, read-modify-write", (uint32_t)(((uint64_t)clockHz * accessRepeats) / oldToggle), "toggles/s");
+
+    redLed.write(1);
+    blueLed.write(1);
+    check((blueLed.read() == 1) && (redLed.read() == 1), "Masked writes set their pins");
+
+    blueLed.toggle();
+    check((blueLed.read() == 0) && (redLed.read() == 1), "Toggle leaves the other pins of the port");
+
+    redLed.write(0);
+    check(blueLed.read() == 0, "Write leaves the other pins of the port");
+    printf("\n");
+}
+
+/**
+ * @brief Byte writes to PB0 - PB7 with one GpioPort store against eight 
+ *        Gpio writes, and the byte throughput of both.
+ */
+void gpioPortBenchmark(void)
+{
+    GpioPort bus;
+    Gpio line[portBPins];
+
+    bus.initialize(gpioBlock::portB, 0xFF, output);
+
+    for(uint32_t pin = 0; pin < portBPins; pin++)
+    {
+        line[pin].initialize((uint32_t)PB0::GPIO + (pin * gpioOffset), output);
+    }
+
+    printf("GpioPort byte write, PB0 - PB7\n");
+
+    uint32_t primask = Nvic::disableInterrupts();
+    uint32_t overhead = measureEmptyLoop(accessRepeats);
+    uint32_t start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        bus.write(i);
+    }
+
+    uint32_t portWrite = Dwt::getCycleCount() - start;
+    start = Dwt::getCycleCount();
+
+    for(uint32_t i = 0; i < accessRepeats; i++)
+    {
+        for(uint32_t pin = 0; pin < portBPins; pin++)
+        {
+            line[pin].write((i >> pin) & 0x1);
+        }
+    }
+
+    uint32_t pinWrites = Dwt::getCycleCount() - start;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    uint32_t clockHz = SystemControl::getSystemClockHz();
+
+    reportCycles("byte write, one masked store", portWrite - overhead, accessRepeats);
+    reportCycles("byte write, 8 Gpio writes", pinWrites - overhead, accessRepeats);
+    reportValue("byte throughput in a loop, one masked store", (uint32_t)(((uint64_t)clockHz * accessRepeats) / portWrite), "bytes/s");
+    reportValue("byte throughput in a loop, 8 Gpio writes", (uint32_t)(((uint64_t)clockHz * accessRepeats) / pinWrites), "bytes/s");
+
+    bool matches = true;
+
+    for(uint32_t value = 0; value < 0x100; value += 0x11)
+    {
+        bus.write(value);
+
+        if(bus.read() != value)
+        {
+            matches = false;
+        }
+
+        for(uint32_t pin = 0; pin < portBPins; pin++)
+        {
+            line[pin].write((~value >> pin) & 0x1);
+        }
+
+        if(bus.read() != (~value & 0xFF))
+        {
+            matches = false;
+        }
+    }
+
+    check(matches, "Both paths drive the same byte");
+    bus.write(0);
+    printf("\n");
+}
+
+/**
+ * @brief Times Gpio::dispatchInterrupt for a given set of pending pins.
+ * 
+ * @details The pins are toggled with interrupts masked, so their edges are 
+ *          latched in GPIOMIS and the dispatcher is called directly instead
+ *          of from the port handler.
+ * 
+ * @param line the pins of port B.
+ * @param pins pending pin mask to create.
+ * @param maxCycles most cycles one dispatch took.
+ * 
+ * @return cycles of all dispatches.
+ */
+static uint32_t timeDispatch(Gpio* line, uint32_t pins, uint32_t* maxCycles)
+{
+    uint32_t total = 0;
+
+    *maxCycles = 0;
+
+    for(uint32_t r = 0; r < dispatchRepeats; r++)
+    {
+        for(uint32_t pin = 0; pin < portBPins; pin++)
+        {
+            if(((pins >> pin) & 0x1) != 0)
+            {
+                line[pin].toggle();
+            }
+        }
+
+        waitCycles(10); //Input synchronizer
+
+        uint32_t start = Dwt::getCycleCount();
+        Gpio::dispatchInterrupt(portB);
+        uint32_t cycles = Dwt::getCycleCount() - start;
+
+        total += cycles;
+
+        if(cycles > *maxCycles)
+        {
+            *maxCycles = cycles;
+        }
+    }
+
+    return(total);
+}
+
+/**
+ * @brief Cycles of the per pin interrupt dispatcher with 0, 1 and 8 pending
+ *        pins of port B, callbacks included.
+ */
+void gpioDispatchBenchmark(void)
+{
+    Gpio line[portBPins];
+
+    for(uint32_t pin = 0; pin < portBPins; pin++)
+    {
+        line[pin].initialize((uint32_t)PB0::GPIO + (pin * gpioOffset), output, 3, interruptSense::bothEdges, countCallback, 0);
+    }
+
+    printf("Gpio interrupt dispatcher, port B\n");
+
+    uint32_t primask = Nvic::disableInterrupts();
+    uint32_t maxNone = 0;
+    uint32_t maxOne = 0;
+    uint32_t maxAll = 0;
+
+    timeDispatch(line, 0x00, &maxNone); //Clear anything latched by the setup
+    callbackCount = 0;
+
+    uint32_t none = timeDispatch(line, 0x00, &maxNone);
+    uint32_t noneCallbacks = callbackCount;
+    uint32_t one = timeDispatch(line, 0x01, &maxOne);
+    uint32_t oneCallbacks = callbackCount - noneCallbacks;
+    uint32_t all = timeDispatch(line, 0xFF, &maxAll);
+    uint32_t allCallbacks = callbackCount - noneCallbacks - oneCallbacks;
+
+    if(primask == 0)
+    {
+        Nvic::enableInterrupts();
+    }
+
+    reportCycles("dispatch, no pin pending", none, dispatchRepeats);
+    reportCycles("dispatch, 1 pin pending", one, dispatchRepeats);
+    reportCycles("dispatch, 8 pins pending", all, dispatchRepeats);
+    reportValue("dispatch, 1 pin pending, worst", maxOne, "cycles");
+    reportValue("dispatch, 8 pins pending, worst", maxAll, "cycles");
+    reportCycles("dispatch, each further pending pin", all - one, dispatchRepeats * (portBPins - 1));
+
+    check(noneCallbacks == 0, "No callback without a pending pin");
+    check(oneCallbacks == dispatchRepeats, "One callback per edge of 1 pin");
+    check(allCallbacks == (dispatchRepeats * portBPins), "One callback per edge of 8 pins");
+    printf("\n");
+}
+
+/**
+ * @brief Drives a train of \c pulseCount pulses on a pin and counts its 
+ *        interrupts.
+ * 
+ * @param pin output with a counting interrupt callback.
+ * @param elapsed cycles the train took.
+ * 
+ * @return interrupts taken.
+ */
+static uint32_t countPulseInterrupts(Gpio& pin, uint32_t* elapsed)
+{
+    uint32_t before = callbackCount;
+    uint32_t start = Dwt::getCycleCount();
+
+    for(uint32_t p = 0; p < pulseCount; p++)
+    {
+        pin.write(1);
+        waitCycles(pulseHalfPeriod);
+        pin.write(0);
+        waitCycles(pulseHalfPeriod);
+    }
+
+    *elapsed = Dwt::getCycleCount() - start;
+
+    return(callbackCount - before);
+}
+
+/**
+ * @brief Interrupts taken on a known pulse train with each edge sense, the 
+ *        interrupt rate reduction of a single edge against both edges.
+ */
+void gpioInterruptSenseBenchmark(void)
+{
+    Gpio pulse;
+    uint32_t elapsed = 0;
+    uint64_t clockHz = SystemControl::getSystemClockHz();
+
+    pulse.initialize<Pin<PB0, PB0::GPIO>>(output, 3, interruptSense::bothEdges, countCallback, 0);
+    pulse.write(0);
+
+    printf("Gpio interrupt sense, %u pulses on PB0\n", (unsigned)pulseCount);
+
+    uint32_t bothEdges = countPulseInterrupts(pulse, &elapsed);
+    uint32_t bothEdgesRate = (uint32_t)((clockHz * bothEdges) / elapsed);
+
+    pulse.setInterruptSense(interruptSense::risingEdge);
+    uint32_t rising = countPulseInterrupts(pulse, &elapsed);
+    uint32_t risingRate = (uint32_t)((clockHz * rising) / elapsed);
+
+    pulse.setInterruptSense(interruptSense::fallingEdge);
+    uint32_t falling = countPulseInterrupts(pulse, &elapsed);
+
+    reportValue("interrupts, both edges", bothEdges, "interrupts");
+    reportValue("interrupts, rising edge", rising, "interrupts");
+    reportValue("interrupts, falling edge", falling, "interrupts");
+    reportValue("interrupt rate, both edges", bothEdgesRate, "interrupts/s");
+    reportValue("interrupt rate, rising edge", risingRate, "interrupts/s");
+
+    if(bothEdges != 0)
+    {
+        reportValue("interrupt rate reduction, rising edge", 100 - ((100 * rising) / bothEdges), "%");
+    }
+
+    check(bothEdges == (2 * pulseCount), "Both edges interrupt twice per pulse");
+    check(rising == pulseCount, "Rising edge interrupts once per pulse");
+    check(falling == pulseCount, "Falling edge interrupts once per pulse");
+    printf("\n");
+}
@@ -28,6 +28,7 @@
  */
 
 #include "generalPurposeTimer.h"
+#include "../systemControl/powerManager.h"
 
 const uint32_t GeneralPurposeTimer::timerBaseAddresses[12] = {_16_32_bit_Timer_0_base, _16_32_bit_Timer_1_base, _16_32_bit_Timer_2_base, _16_32_bit_Timer_3_base, _16_32_bit_Timer_4_base, _16_32_bit_Timer_5_base,
     _32_64_bit_Wide_Timer_0_base, _32_64_bit_Wide_Timer_1_base, _32_64_bit_Wide_Timer_2_base, _32_64_bit_Wide_Timer_3_base, _32_64_bit_Wide_Timer_4_base, _32_64_bit_Wide_Timer_5_base};
@@ -50,19 +51,32 @@ const uint32_t GeneralPurposeTimer::GPTMTnPS_OFFSET[2] = {GPTMTAPS_OFFSET, GPTMT
 const uint32_t GeneralPurposeTimer::GPTMTnPV_OFFSET[2] = {GPTMTAPV_OFFSET, GPTMTBPV_OFFSET};
 
 /**
- * @brief empty constructor placeholder
+ * @brief Marks the object as holding no clock and no clock change 
+ *        notifier, so the destructor and a re-initialization release 
+ *        nothing until they are acquired, and as no ADC trigger.
  */
 GeneralPurposeTimer::GeneralPurposeTimer()
 {
-  
+    clockAcquired = false;
+    notifierRegistered = false;
+    triggerRateHz = 0;
+    triggerLoad = 0;
 }
 
 /**
- * @brief empty deconstructor placeholder
+ * @brief Releases the timer block clock if the timer was initialized.
  */
 GeneralPurposeTimer::~GeneralPurposeTimer()
 {
+    if(notifierRegistered == true)
+    {
+        SystemControl::unregisterClockChangeNotifier(systemClockChanged, this);
+    }
 
+    if(clockAcquired == true)
+    {
+        PowerManager::release(((block/6) == 0) ? clockGatedPeripheral::timer : clockGatedPeripheral::wideTimer, (0x1 << (block%6)), (uint32_t)clockGateMode::run);
+    }
 }
 
 /**
@@ -80,19 +94,27 @@ GeneralPurposeTimer::~GeneralPurposeTimer()
  */
 void GeneralPurposeTimer::initialize(timerMode mode, timerBlock block, uint32_t clockCycles, countDirection dir, timerUse use)
 {
+    if(clockAcquired == true)
+    {
+        PowerManager::release((((*this).block/6) == 0) ? clockGatedPeripheral::timer : clockGatedPeripheral::wideTimer, (0x1 << ((*this).block%6)), (uint32_t)clockGateMode::run);
+    }
+
     (*this).use = use;
+    (*this).block = block;
     clockCycles = clockCycles - 1;
     baseAddress = timerBaseAddresses[block];
 
+    //No longer an ADC trigger, the clock change notifier leaves the load alone
+    triggerRateHz = 0;
+    triggerLoad = 0;
+
     //0. Enable the clock for the timer
-    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + RCGCnTIMER_OFFSET[block/6])), (uint32_t)setORClear::set, (block%6), 1, RW);
-    while(Register::getRegisterBitFieldStatus(((volatile uint32_t*)(systemControlBase + PRnTIMER_OFFSET[block/6])), (block%6), 1, RO) == 0)
-    {
-        //Ready?
-    }
+    PowerManager::acquire(((block/6) == 0) ? clockGatedPeripheral::timer : clockGatedPeripheral::wideTimer, (0x1 << (block%6)), (uint32_t)clockGateMode::run);
+    clockAcquired = true;
 
     //1. Disbale the timer before making any changes
     Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPTMCTL_OFFSET)), (uint32_t)setORClear::clear, (use%2)*8, 1, RW); //disable the timer
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPTMCTL_OFFSET)), (uint32_t)setORClear::clear, 5, 1, RW); //no ADC trigger output, TAOTE
     if((mode == oneShot) || (mode == periodic))
     {
         rawInterruptStatusBit = ((use == timerB) ? 8 : 0);
@@ -260,6 +282,106 @@ void GeneralPurposeTimer::initializeForInterupt(timerMode mode, timerBlock block
 }
 
 
+/**
+ * @brief Initializes a periodic timer that triggers ADC sampling at a fixed 
+ *        rate in hardware, with no interrupt handler or processor trigger.
+ * 
+ * @details The timer is concatenated, counts down and has its ADC trigger 
+ *          output (GPTMCTL TAOTE) enabled. The ADC sees the OR of the trigger
+ *          outputs of every timer, set a sequencer trigger to 
+ *          \c ssTriggerSource::timer to use it. The interval load is rounded 
+ *          to the nearest system clock cycle and recomputed after every 
+ *          system clock change. The timer is started with \c enableTimer .
+ *          Initializing the timer again for another use turns the trigger 
+ *          output off and stops the reloads.
+ * 
+ * @param block of the timer used.
+ * @param triggerRateHz triggers per second, 1 to the system clock.
+ * 
+ * @return achieved trigger rate in Hz.
+ */
+uint32_t GeneralPurposeTimer::initializeForAdcTrigger(timerBlock block, uint32_t triggerRateHz)
+{
+    if(triggerRateHz == 0)
+    {
+        triggerRateHz = 1;
+    }
+
+    uint32_t systemClockHz = SystemControl::getSystemClockHz();
+    uint32_t load = (systemClockHz + (triggerRateHz / 2)) / triggerRateHz;
+
+    if(load == 0)
+    {
+        load = 1;
+    }
+
+    initialize(periodic, block, load, down, concatenated);
+
+    (*this).triggerRateHz = triggerRateHz;
+    triggerLoad = load;
+
+    //Enable the timer A ADC trigger output, TAOTE
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPTMCTL_OFFSET)), (uint32_t)setORClear::set, 5, 1, RW);
+
+    if(notifierRegistered == false)
+    {
+        notifierRegistered = SystemControl::registerClockChangeNotifier(systemClockChanged, this);
+    }
+
+    return(systemClockHz / triggerLoad);
+}
+
+/**
+ * @brief Stops the timer, its ADC trigger output stays configured.
+ */
+void GeneralPurposeTimer::disableTimer(void)
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(baseAddress + GPTMCTL_OFFSET)), (uint32_t)setORClear::clear, (use%2)*8, 1, RW);
+}
+
+/**
+ * @brief Gets the trigger rate achieved by \c initializeForAdcTrigger at the 
+ *        current system clock.
+ * 
+ * @return trigger rate in Hz, 0 if the timer is not an ADC trigger.
+ */
+uint32_t GeneralPurposeTimer::getTriggerRateHz(void)
+{
+    if(triggerLoad == 0)
+    {
+        return(0);
+    }
+
+    return(SystemControl::getSystemClockHz() / triggerLoad);
+}
+
+/**
+ * @brief Clock change notifier, reloads the ADC trigger period for the new 
+ *        system clock.
+ * 
+ * @param systemClockHz new system clock in Hz.
+ * @param context the GeneralPurposeTimer.
+ */
+void GeneralPurposeTimer::systemClockChanged(uint32_t systemClockHz, void* context)
+{
+    GeneralPurposeTimer* timer = (GeneralPurposeTimer*)context;
+
+    if((*timer).triggerRateHz == 0)
+    {
+        return;
+    }
+
+    uint32_t load = (systemClockHz + ((*timer).triggerRateHz / 2)) / (*timer).triggerRateHz;
+
+    if(load == 0)
+    {
+        load = 1;
+    }
+
+    (*timer).triggerLoad = load;
+    *((volatile uint32_t*)((*timer).baseAddress + GPTMTAILR_OFFSET)) = load - 1;
+}
+
 /**
  * @brief To be used in a poll loop. Checks the Raw Interrupt Status of the timer.
  */
@@ -133,22 +133,33 @@ class GeneralPurposeTimer
     public:
         GeneralPurposeTimer();
         ~GeneralPurposeTimer();
+        GeneralPurposeTimer(const GeneralPurposeTimer&) = delete;
+        GeneralPurposeTimer& operator=(const GeneralPurposeTimer&) = delete;
 
         void initializeForPolling(timerMode mode, timerBlock block, uint32_t clockCycles, countDirection dir, timerUse use, void (*action)(void));
         void initializeForInterupt(timerMode mode, timerBlock block, uint32_t clockCycles, countDirection dir, timerUse use, uint32_t interuptPriority);
+        uint32_t initializeForAdcTrigger(timerBlock block, uint32_t triggerRateHz);
 
         void pollStatus(void);
         void clearInterrupt(void);
         void enableTimer(void);
+        void disableTimer(void);
+        uint32_t getTriggerRateHz(void);
 
     private:
 
         void initialize(timerMode mode, timerBlock block, uint32_t clockCycles, countDirection dir, timerUse use);
+        static void systemClockChanged(uint32_t systemClockHz, void* context);
 
         void (*action)(void);
         timerUse use;
+        timerBlock block;
+        bool clockAcquired;
         uint32_t rawInterruptStatusBit;
         uint32_t baseAddress;
+        uint32_t triggerRateHz;
+        uint32_t triggerLoad;
+        bool notifierRegistered;
 
         static const uint32_t _16_32_bit_Timer_0_base = 0x40030000;
         static const uint32_t _16_32_bit_Timer_1_base = 0x40031000;
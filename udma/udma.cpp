@@ -28,6 +28,7 @@
  */
 
 #include "udma.h"
+#include "../systemControl/powerManager.h"
 
 /**
  * @brief empty constructor placeholder
@@ -43,4 +44,155 @@ Dma::Dma()
 Dma::~Dma()
 {
 
-}
\ No newline at end of file
+}
+dmaControlStructure Dma::controlTable[2 * channelCount] __attribute__((aligned(1024)));
+bool Dma::initialized;
+
+/**
+ * @brief Enables the μDMA controller and sets the channel control table.
+ * 
+ * @details Safe to call from every driver that uses a channel, only the first
+ *          call has an effect.
+ */
+void Dma::initialize(void)
+{
+    if(initialized == true)
+    {
+        return;
+    }
+
+    PowerManager::acquire(clockGatedPeripheral::dma, 0x1, (uint32_t)clockGateMode::run);
+
+    //Enable the controller, MASTEN
+    *((volatile uint32_t*)(uDMA_Base + DMACFG_OFFSET)) = 0x1;
+    *((volatile uint32_t*)(uDMA_Base + DMACTLBASE_OFFSET)) = (uint32_t)(uintptr_t)controlTable;
+
+    initialized = true;
+}
+
+/**
+ * @brief Maps a channel to one of its peripherals.
+ * 
+ * @param channel 0 to 31.
+ * @param encoding the \\c Enc. column of the channel assignment table, 0 to 4.
+ */
+void Dma::assignChannel(uint32_t channel, uint32_t encoding)
+{
+    Register::setRegisterBitFieldStatus(((volatile uint32_t*)(uDMA_Base + DMACHMAP0_OFFSET + ((channel / 8) * 0x4))), encoding, (channel % 8) * 4, 4, RW);
+}
+
+/**
+ * @brief Sets the request type and priority of a channel, unmasks its 
+ *        requests and selects the primary control structure.
+ * 
+ * @param channel 0 to 31.
+ * @param useBurst true to respond to burst requests only.
+ * @param highPriority true for the high priority level.
+ */
+void Dma::configureChannel(uint32_t channel, bool useBurst, bool highPriority)
+{
+    uint32_t channelMask = 0x1 << channel;
+
+    if(useBurst == true)
+    {
+        *((volatile uint32_t*)(uDMA_Base + DMAUSEBURSTSET_OFFSET)) = channelMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(uDMA_Base + DMAUSEBURSTCLR_OFFSET)) = channelMask;
+    }
+
+    if(highPriority == true)
+    {
+        *((volatile uint32_t*)(uDMA_Base + DMAPRIOSET_OFFSET)) = channelMask;
+    }
+
+    else
+    {
+        *((volatile uint32_t*)(uDMA_Base + DMAPRIOCLR_OFFSET)) = channelMask;
+    }
+
+    *((volatile uint32_t*)(uDMA_Base + DMAALTCLR_OFFSET)) = channelMask;
+    *((volatile uint32_t*)(uDMA_Base + DMAREQMASKCLR_OFFSET)) = channelMask;
+}
+
+/**
+ * @brief Sets up the primary or alternate control structure of a channel.
+ * 
+ * @details The end pointers are the addresses of the last item, or the fixed
+ *          address when the side does not increment. The control word is 
+ *          written last, so a ping-pong structure is only picked up once it
+ *          is complete.
+ * 
+ * @param channel 0 to 31.
+ * @param alternate true for the alternate control structure.
+ * @param sourceEnd address of the last source item.
+ * @param destinationEnd address of the last destination item.
+ * @param control control word from \\c makeControl .
+ */
+void Dma::setTransfer(uint32_t channel, bool alternate, volatile const void* sourceEnd, volatile void* destinationEnd, uint32_t control)
+{
+    dmaControlStructure* structure = &controlTable[channel + (alternate ? channelCount : 0)];
+
+    (*structure).sourceEnd = sourceEnd;
+    (*structure).destinationEnd = destinationEnd;
+    (*structure).control = control;
+}
+
+/**
+ * @brief Gets the transfer mode of a control structure, \\c dmaMode::stop once
+ *        it has completed.
+ * 
+ * @param channel 0 to 31.
+ * @param alternate true for the alternate control structure.
+ * 
+ * @return transfer mode.
+ */
+dmaMode Dma::getMode(uint32_t channel, bool alternate)
+{
+    return((dmaMode)(controlTable[channel + (alternate ? channelCount : 0)].control & 0x7));
+}
+
+/**
+ * @brief Enables a channel.
+ * 
+ * @param channel 0 to 31.
+ */
+void Dma::enableChannel(uint32_t channel)
+{
+    *((volatile uint32_t*)(uDMA_Base + DMAENASET_OFFSET)) = 0x1 << channel;
+}
+
+/**
+ * @brief Disables a channel.
+ * 
+ * @param channel 0 to 31.
+ */
+void Dma::disableChannel(uint32_t channel)
+{
+    *((volatile uint32_t*)(uDMA_Base + DMAENACLR_OFFSET)) = 0x1 << channel;
+}
+
+/**
+ * @brief Checks if a channel is enabled, the controller disables a channel 
+ *        when it runs into a stopped control structure.
+ * 
+ * @param channel 0 to 31.
+ * 
+ * @return true if the channel is enabled.
+ */
+bool Dma::isChannelEnabled(uint32_t channel)
+{
+    return(((*((volatile uint32_t*)(uDMA_Base + DMAENASET_OFFSET)) >> channel) & 0x1) != 0);
+}
+
+/**
+ * @brief Clears the completion interrupt of a channel with a single store.
+ * 
+ * @param channel 0 to 31.
+ */
+void Dma::clearChannelInterrupt(uint32_t channel)
+{
+    *((volatile uint32_t*)(uDMA_Base + DMACHIS_OFFSET)) = 0x1 << channel;
+}
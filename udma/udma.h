@@ -92,6 +92,22 @@
  * @image latex udmaChannelAssignments.png
  * @image latex udmaChannelAssignments2.png
  * 
+ * @subsection udmaUsage μDMA Usage
+ * 
+ * The Dma class is static, there is a single μDMA controller. \c initialize 
+ * enables the controller and points it at a 1024 byte aligned channel control
+ * table in SRAM, with a primary and an alternate control structure for each
+ * of the 32 channels. A driver that uses a channel maps it to its peripheral
+ * with \c assignChannel , sets up the control structures with \c setTransfer 
+ * and \c makeControl and enables the channel. Peripheral channels signal
+ * transfer completion on the interrupt vector of the peripheral, the handler 
+ * clears it with \c clearChannelInterrupt .
+ * 
+ * In ping-pong mode the controller switches between the primary and the 
+ * alternate structure every time one completes, the handler refills the 
+ * completed structure while the other one runs. If both complete before the
+ * handler runs the channel is disabled by the controller.
+ * 
  */
 
 
@@ -100,14 +116,73 @@
 
 #include "../systemControl/systemControl.h"
 
+/**
+ * Size of one transfer item, DMACHCTL SRCSIZE and DSTSIZE
+ */
+enum class dmaSize : uint32_t {byte = 0x0, halfWord = 0x1, word = 0x2};
+
+/**
+ * Address increment after each item, DMACHCTL SRCINC and DSTINC
+ */
+enum class dmaIncrement : uint32_t {byte = 0x0, halfWord = 0x1, word = 0x2, none = 0x3};
+
+/**
+ * Transfer mode, DMACHCTL XFERMODE
+ */
+enum class dmaMode : uint32_t {stop = 0x0, basic = 0x1, autoRequest = 0x2, pingPong = 0x3, memoryScatterGather = 0x4, peripheralScatterGather = 0x6};
+
+/**
+ * Channel control structure, one entry of the channel control table
+ */
+struct dmaControlStructure
+{
+    volatile const void* volatile sourceEnd; //Address of the last source item
+    volatile void* volatile destinationEnd; //Address of the last destination item
+    volatile uint32_t control; //DMACHCTL control word
+    uint32_t unused;
+};
+
 class Dma
 {
     public:
         Dma();
         ~Dma();
 
+        static void initialize(void);
+        static void assignChannel(uint32_t channel, uint32_t encoding);
+        static void configureChannel(uint32_t channel, bool useBurst, bool highPriority);
+        static void setTransfer(uint32_t channel, bool alternate, volatile const void* sourceEnd, volatile void* destinationEnd, uint32_t control);
+        static dmaMode getMode(uint32_t channel, bool alternate);
+        static void enableChannel(uint32_t channel);
+        static void disableChannel(uint32_t channel);
+        static bool isChannelEnabled(uint32_t channel);
+        static void clearChannelInterrupt(uint32_t channel);
+
+        /**
+         * @brief Builds a DMACHCTL control word.
+         * 
+         * @param size of one item, the source and destination size are equal.
+         * @param sourceIncrement source address increment.
+         * @param destinationIncrement destination address increment.
+         * @param arbitrationLog2 log2 of the items moved per request, 0 to 10.
+         * @param itemCount items to transfer, 1 to 1024.
+         * @param mode transfer mode.
+         * 
+         * @return control word for \c setTransfer .
+         */
+        static constexpr uint32_t makeControl(dmaSize size, dmaIncrement sourceIncrement, dmaIncrement destinationIncrement, uint32_t arbitrationLog2, uint32_t itemCount, dmaMode mode)
+        {
+            return(((uint32_t)destinationIncrement << 30) | ((uint32_t)size << 28) | ((uint32_t)sourceIncrement << 26) | ((uint32_t)size << 24) | (arbitrationLog2 << 14) | ((itemCount - 1) << 4) | (uint32_t)mode);
+        }
+
+        static const uint32_t channelCount = 32;
+        static const uint32_t maxItemCount = 1024;
+
     private:
 
+        static dmaControlStructure controlTable[2 * channelCount] __attribute__((aligned(1024)));
+        static bool initialized;
+
         static const uint32_t uDMA_Base = 0x400FF000;
 
         static const uint32_t PPDMA_OFFSET = 0x30C; //0x30C PPDMA RO 0x0000.0001 Micro Direct Memory Access Peripheral Present 293